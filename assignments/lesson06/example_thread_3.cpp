@@ -1,6 +1,9 @@
+#include <future>
 #include <iostream>
 #include <mutex>
-#include <thread>
+#include <vector>
+
+#include "thread_pool.h"
 
 std::mutex mutex;  // Мьютекс для защиты общего ресурса
 int sharedResource = 0;  // Общий ресурс
@@ -12,16 +15,18 @@ void increment() {
 }
 
 int main() {
-  std::thread threads[10];  // Массив потоков
+  // Потоки пула создаются один раз; задача гораздо дешевле нового потока
+  ThreadPool pool;
+  std::vector<std::future<void>> results;
 
-  // Создаем 10 потоков
+  // Ставим 10 задач в пул
   for (int i = 0; i < 10; ++i) {
-    threads[i] = std::thread(increment);  // Инициализация каждого потока
+    results.push_back(pool.submit(increment));
   }
 
-  // Ожидание завершения всех потоков
-  for (int i = 0; i < 10; ++i) {
-    threads[i].join();  // Присоединение каждого потока
+  // Ожидание завершения всех задач
+  for (auto& result : results) {
+    result.get();
   }
 
   std::cout << "Общий ресурс: " << sharedResource
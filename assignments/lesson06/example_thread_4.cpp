@@ -1,6 +1,7 @@
 #include <iostream>
 #include <vector>
-#include <thread>
+
+#include "parallel_for.h"
 
 void processPart(const std::vector<int>& arr, int start, int end) {
     for (int i = start; i < end; ++i) {
@@ -12,21 +13,14 @@ void processPart(const std::vector<int>& arr, int start, int end) {
 int main() {
     std::vector<int> arr = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
     const int numThreads = 2; // Количество потоков
-    std::thread threads[numThreads];
-
-    int chunkSize = arr.size() / numThreads;
-
-    // Создание потоков с указанием границ
-    for (int i = 0; i < numThreads; ++i) {
-        int start = i * chunkSize;
-        int end = (i == numThreads - 1) ? arr.size() : (i + 1) * chunkSize; // Обработка последнего сегмента
-        threads[i] = std::thread(processPart, std::ref(arr), start, end);
-    }
+    ThreadPool pool(numThreads);
+    const size_t grain = 2; // Меньше этого куски не дробятся
 
-    // Ожидание завершения всех потоков
-    for (int i = 0; i < numThreads; ++i) {
-        threads[i].join();
-    }
+    // Границы кусков выбирает parallel_for: освободившийся поток
+    // забирает часть ещё не обработанных элементов у другого
+    parallel_for(pool, {0, arr.size()}, grain, [&arr](size_t start, size_t end) {
+        processPart(arr, start, end);
+    });
 
     return 0;
-}
\ No newline at end of file
+}
@@ -1,42 +1,30 @@
 #include <iostream>
-#include <vector>
-#include <thread>
-#include <mutex>
 
-std::mutex mutex; // Мьютекс для защиты общего ресурса
-std::vector<int> sharedArr(10, 0); // Общий вектор, который потоки будут изменять
+#include "partitioned_array.h"
+#include "thread_pool.h"
 
-void incrementPart(int start, int end) {
-    for (int i = start; i < end; ++i) {
-        // Блокируем мьютекс для безопасного доступа к sharedArr
-        mutex.lock();
-        sharedArr[i] += 1; // Увеличиваем элемент
-        mutex.unlock();
+const int numThreads = 2; // Количество потоков
+// Общий массив поделён поровну между потоками; каждая часть — в своих кэш-линиях
+PartitionedArray<int> sharedArr(10, numThreads, 0);
+
+void incrementPart(int* start, int* end) {
+    // Часть принадлежит только этому потоку, поэтому мьютекс не нужен
+    for (int* value = start; value != end; ++value) {
+        *value += 1; // Увеличиваем элемент
     }
 }
 
 int main() {
-    const int numThreads = 2; // Количество потоков
-    std::thread threads[numThreads];
-    int chunkSize = sharedArr.size() / numThreads;
+    ThreadPool pool(numThreads);
 
-    // Создание потоков
-    for (int i = 0; i < numThreads; ++i) {
-        int start = i * chunkSize;
-        int end = (i == numThreads - 1) ? sharedArr.size() : (i + 1) * chunkSize;
-        threads[i] = std::thread(incrementPart, start, end);
-    }
-
-    // Ожидание завершения всех потоков
-    for (int i = 0; i < numThreads; ++i) {
-        threads[i].join();
-    }
+    // Каждая часть обновляется своей задачей; ждём завершения всех
+    updateParts(pool, sharedArr, incrementPart);
 
     // Вывод значений вектора
-    for (const auto& value : sharedArr) {
-        std::cout << value << " ";
+    for (size_t i = 0; i < sharedArr.size(); ++i) {
+        std::cout << sharedArr[i] << " ";
     }
     std::cout << std::endl;
 
     return 0;
-}
\ No newline at end of file
+}
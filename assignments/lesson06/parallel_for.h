@@ -0,0 +1,153 @@
+#ifndef LESSON06_PARALLEL_FOR_H
+#define LESSON06_PARALLEL_FOR_H
+
+/*
+ * parallel_for с кражей работы. Обобщает processPart(arr, start, end) из
+ * example_thread_4.cpp: диапазон делится между потоками не раз и навсегда,
+ * а динамически.
+ *
+ * У каждого рабочего своя очередь (deque) кусков диапазона. Рабочий берёт
+ * кусок с конца своей очереди и, пока кусок больше grain, откладывает его
+ * вторую половину обратно в очередь. Освободившийся рабочий крадёт кусок
+ * с начала чужой очереди — там лежат самые крупные. Так потоки, которым
+ * достались дешёвые итерации, забирают часть работы у загруженных.
+ *
+ * fn(start, end) вызывается для непересекающихся кусков, вместе покрывающих
+ * весь диапазон. Вызывать parallel_for из задачи того же пула нельзя.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "thread_pool.h"
+
+struct Range {
+    size_t begin, end;
+
+    size_t size() const { return end - begin; }
+};
+
+namespace detail {
+
+struct StealingQueue {
+    std::mutex mutex;
+    std::deque<Range> ranges;
+
+    void push(Range r) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ranges.push_back(r);
+    }
+
+    // Свой конец очереди
+    bool pop(Range& r) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (ranges.empty()) return false;
+        r = ranges.back();
+        ranges.pop_back();
+        return true;
+    }
+
+    // Чужой конец очереди
+    bool steal(Range& r) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (ranges.empty()) return false;
+        r = ranges.front();
+        ranges.pop_front();
+        return true;
+    }
+};
+
+}
+
+template <typename Fn>
+void parallel_for(ThreadPool& pool, Range range, size_t grain, Fn fn) {
+    if (range.size() == 0) return;
+    if (grain == 0) grain = 1;
+    size_t workers = pool.size();
+
+    std::vector<std::unique_ptr<detail::StealingQueue>> queues;
+    for (size_t w = 0; w < workers; ++w) {
+        queues.emplace_back(new detail::StealingQueue());
+    }
+    // Начальное разбиение — как статическое, дальше балансирует кража
+    size_t part = (range.size() + workers - 1) / workers;
+    for (size_t w = 0; w < workers; ++w) {
+        size_t begin = range.begin + w * part;
+        if (begin >= range.end) break;
+        queues[w]->push({begin, std::min(range.end, begin + part)});
+    }
+
+    // Куски в очередях плюс куски, которые сейчас дробятся: пока счётчик не ноль,
+    // в очередях ещё может появиться работа. Дробление идёт до вызова fn, так что
+    // при нуле новой работы уже не будет и свободный рабочий может выйти
+    std::atomic<size_t> queued(0);
+    for (auto& q : queues) queued += q->ranges.size();
+    std::atomic<bool> failed(false);
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto worker = [&](size_t self) {
+        size_t victim = self;
+        while (!failed.load(std::memory_order_relaxed)) {
+            Range r;
+            bool found = queues[self]->pop(r);
+            for (size_t k = 1; !found && k < workers; ++k) {
+                victim = (victim + 1) % workers;
+                if (victim != self) found = queues[victim]->steal(r);
+            }
+            if (!found) {
+                // Остальное уже у других рабочих: ждать их незачем
+                if (queued.load() == 0) break;
+                // Кто-то дробит кусок, и работа сейчас появится
+                std::this_thread::yield();
+                continue;
+            }
+            while (r.size() > grain) {
+                size_t mid = r.begin + r.size() / 2;
+                queued++;
+                queues[self]->push({mid, r.end});
+                r.end = mid;
+            }
+            queued--;
+            try {
+                fn(r.begin, r.end);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) error = std::current_exception();
+                failed = true;
+            }
+        }
+    };
+
+    std::vector<std::future<void>> done;
+    for (size_t w = 0; w < workers; ++w) {
+        done.push_back(pool.submit(worker, w));
+    }
+    for (auto& d : done) {
+        d.get();
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+// Пул для parallel_for без явного пула: один на всю программу, создаётся
+// при первом вызове. Функция не шаблонная и inline, поэтому экземпляр один
+// и для всех типов fn, и для всех единиц трансляции
+inline ThreadPool& sharedPool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+template <typename Fn>
+void parallel_for(Range range, size_t grain, Fn fn) {
+    parallel_for(sharedPool(), range, grain, fn);
+}
+
+#endif
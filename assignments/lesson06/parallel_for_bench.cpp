@@ -0,0 +1,80 @@
+/*
+ * Неравномерная нагрузка: статическое деление диапазона на равные части
+ * (как в исходном example_thread_4.cpp) против parallel_for с кражей работы.
+ * Стоимость итерации i растёт с i, а каждая сотая итерация ещё и в 50 раз
+ * дороже, поэтому потоку с последним куском достаётся больше всех.
+ *
+ * g++ -std=c++17 -O2 -o parallel_for_bench parallel_for_bench.cpp -pthread
+ */
+
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <iostream>
+#include <vector>
+
+#include "parallel_for.h"
+
+using Clock = std::chrono::steady_clock;
+
+const size_t ITERATIONS = 20000;
+const size_t GRAIN = 16;
+
+std::vector<double> results(ITERATIONS);
+
+void work(size_t i) {
+    size_t steps = 1 + i / 64;
+    if (i % 100 == 0) steps *= 50;
+    double x = i;
+    for (size_t s = 0; s < steps; ++s) {
+        x = std::sqrt(x + s);
+    }
+    results[i] = x;
+}
+
+void processPart(size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+        work(i);
+    }
+}
+
+double milliseconds(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+double staticSplit(ThreadPool& pool) {
+    Clock::time_point start = Clock::now();
+    size_t threads = pool.size();
+    size_t chunk = ITERATIONS / threads;
+    std::vector<std::future<void>> parts;
+    for (size_t t = 0; t < threads; ++t) {
+        size_t begin = t * chunk;
+        size_t end = (t == threads - 1) ? ITERATIONS : (t + 1) * chunk;
+        parts.push_back(pool.submit(processPart, begin, end));
+    }
+    for (auto& part : parts) {
+        part.get();
+    }
+    return milliseconds(start);
+}
+
+double stealing(ThreadPool& pool) {
+    Clock::time_point start = Clock::now();
+    parallel_for(pool, {0, ITERATIONS}, GRAIN, processPart);
+    return milliseconds(start);
+}
+
+int main() {
+    size_t hardware = std::thread::hardware_concurrency();
+    std::cout << "потоков\tстатически, мс\tparallel_for, мс" << std::endl;
+    for (size_t threads : {1, 2, 4, 8}) {
+        ThreadPool pool(threads);
+        // Первый прогон прогревает кэши и потоки пула
+        staticSplit(pool);
+        double split = staticSplit(pool);
+        double stolen = stealing(pool);
+        std::cout << threads << "\t" << split << "\t\t" << stolen
+                  << (threads > hardware ? "\t(больше, чем ядер)" : "") << std::endl;
+    }
+    return 0;
+}
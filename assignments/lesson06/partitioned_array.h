@@ -0,0 +1,96 @@
+#ifndef LESSON06_PARTITIONED_ARRAY_H
+#define LESSON06_PARTITIONED_ARRAY_H
+
+/*
+ * Массив, поделённый на части для параллельного обновления без блокировок.
+ * Элементы делятся между частями поровну, и каждая часть принадлежит одному
+ * потоку: данные частей не пересекаются, поэтому мьютекс не нужен. Каждая
+ * часть начинается с границы кэш-линии и добита до целых линий, что
+ * исключает ложное разделение (false sharing), когда потоки пишут в разные
+ * элементы одной линии и линия мечется между ядрами.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "thread_pool.h"
+
+const size_t CACHE_LINE = 64;
+
+template <typename T>
+class PartitionedArray {
+    static_assert(CACHE_LINE % sizeof(T) == 0, "element size must divide the cache line");
+
+public:
+    static const size_t PER_LINE = CACHE_LINE / sizeof(T);
+
+    // Кусок одной части: [begin, end)
+    struct Slice {
+        T* begin;
+        T* end;
+    };
+
+    PartitionedArray(size_t size, size_t parts, T value = T())
+        : count(size), partCount(parts ? parts : 1) {
+        size_t longest = (count + partCount - 1) / partCount;
+        stride = (longest + PER_LINE - 1) / PER_LINE * PER_LINE;
+        // Один выровненный буфер на все части, вместе с добивкой
+        data = static_cast<T*>(::operator new[](stride * partCount * sizeof(T), std::align_val_t(CACHE_LINE)));
+        std::uninitialized_fill_n(data, stride * partCount, value);
+    }
+
+    ~PartitionedArray() {
+        std::destroy_n(data, stride * partCount);
+        ::operator delete[](data, std::align_val_t(CACHE_LINE));
+    }
+
+    PartitionedArray(const PartitionedArray&) = delete;
+    PartitionedArray& operator=(const PartitionedArray&) = delete;
+
+    size_t size() const { return count; }
+    size_t parts() const { return partCount; }
+
+    T& operator[](size_t i) { return data[slot(i)]; }
+    const T& operator[](size_t i) const { return data[slot(i)]; }
+
+    // Часть p — элементы [p * size / parts, (p + 1) * size / parts); пустой
+    // часть бывает, только если элементов меньше, чем частей
+    Slice part(size_t p) {
+        T* begin = data + p * stride;
+        return {begin, begin + (first(p + 1) - first(p))};
+    }
+
+private:
+    size_t count;
+    size_t partCount;
+    // Расстояние между началами соседних частей: самая длинная часть, добитая до целых линий
+    size_t stride;
+    T* data;
+
+    size_t first(size_t p) const { return p * count / partCount; }
+
+    // Позиция i-го элемента в буфере: i лежит в последней части p с first(p) <= i
+    size_t slot(size_t i) const {
+        size_t p = ((i + 1) * partCount - 1) / count;
+        return p * stride + (i - first(p));
+    }
+};
+
+// Вызывает fn(begin, end) для каждой части в отдельной задаче пула и ждёт все
+template <typename T, typename Fn>
+void updateParts(ThreadPool& pool, PartitionedArray<T>& array, Fn fn) {
+    std::vector<std::future<void>> done;
+    for (size_t p = 0; p < array.parts(); ++p) {
+        typename PartitionedArray<T>::Slice slice = array.part(p);
+        done.push_back(pool.submit(fn, slice.begin, slice.end));
+    }
+    for (auto& d : done) {
+        d.get();
+    }
+}
+
+#endif
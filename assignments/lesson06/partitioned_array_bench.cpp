@@ -0,0 +1,106 @@
+/*
+ * Три способа увеличить каждый элемент общего массива из нескольких потоков:
+ *   mutex          — мьютекс на каждый элемент, как в исходном example_thread_5.cpp;
+ *   false sharing  — без блокировок, но потоки берут элементы через один,
+ *                    так что все пишут в одни и те же кэш-линии;
+ *   partitioned    — PartitionedArray: у каждого потока свои кэш-линии.
+ * Печатается время на одно обновление элемента.
+ *
+ * g++ -std=c++17 -O2 -o partitioned_array_bench partitioned_array_bench.cpp -pthread
+ */
+
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+#include "partitioned_array.h"
+#include "thread_pool.h"
+
+using Clock = std::chrono::steady_clock;
+
+const size_t ELEMENTS = 1 << 20;
+const int PASSES = 4;
+
+std::mutex mutex;
+
+double nanosecondsPerUpdate(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / (double(ELEMENTS) * PASSES);
+}
+
+template <typename Task>
+void runOnEachThread(ThreadPool& pool, Task task) {
+    std::vector<std::future<void>> done;
+    for (size_t t = 0; t < pool.size(); ++t) {
+        done.push_back(pool.submit(task, t));
+    }
+    for (auto& d : done) {
+        d.get();
+    }
+}
+
+double withMutex(ThreadPool& pool, std::vector<int>& arr) {
+    size_t threads = pool.size();
+    Clock::time_point start = Clock::now();
+    for (int pass = 0; pass < PASSES; ++pass) {
+        runOnEachThread(pool, [&](size_t t) {
+            size_t begin = t * arr.size() / threads, end = (t + 1) * arr.size() / threads;
+            for (size_t i = begin; i < end; ++i) {
+                mutex.lock();
+                arr[i] += 1;
+                mutex.unlock();
+            }
+        });
+    }
+    return nanosecondsPerUpdate(start);
+}
+
+double withFalseSharing(ThreadPool& pool, std::vector<int>& arr) {
+    size_t threads = pool.size();
+    Clock::time_point start = Clock::now();
+    for (int pass = 0; pass < PASSES; ++pass) {
+        runOnEachThread(pool, [&](size_t t) {
+            // volatile не даёт компилятору собрать записи в векторные
+            volatile int* data = arr.data();
+            for (size_t i = t; i < arr.size(); i += threads) {
+                data[i] = data[i] + 1;
+            }
+        });
+    }
+    return nanosecondsPerUpdate(start);
+}
+
+double partitioned(ThreadPool& pool, PartitionedArray<int>& arr) {
+    Clock::time_point start = Clock::now();
+    for (int pass = 0; pass < PASSES; ++pass) {
+        updateParts(pool, arr, [](int* begin, int* end) {
+            volatile int* data = begin;
+            for (size_t i = 0; i < size_t(end - begin); ++i) {
+                data[i] = data[i] + 1;
+            }
+        });
+    }
+    return nanosecondsPerUpdate(start);
+}
+
+int main() {
+    std::cout << "Ядер: " << std::thread::hardware_concurrency() << ", элементов: " << ELEMENTS << std::endl;
+    std::cout << "потоков\tmutex, нс\tfalse sharing, нс\tpartitioned, нс" << std::endl;
+    for (size_t threads : {1, 2, 4, 8, 16, 32, 64}) {
+        ThreadPool pool(threads);
+        std::vector<int> locked(ELEMENTS, 0), shared(ELEMENTS, 0);
+        PartitionedArray<int> owned(ELEMENTS, threads, 0);
+
+        double a = withMutex(pool, locked);
+        double b = withFalseSharing(pool, shared);
+        double c = partitioned(pool, owned);
+
+        bool ok = true;
+        for (size_t i = 0; i < ELEMENTS; ++i) {
+            ok = ok && locked[i] == PASSES && shared[i] == PASSES && owned[i] == PASSES;
+        }
+        std::cout << threads << "\t" << a << "\t\t" << b << "\t\t\t" << c << (ok ? "" : "\tОШИБКА") << std::endl;
+    }
+    return 0;
+}
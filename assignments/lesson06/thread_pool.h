@@ -0,0 +1,101 @@
+#ifndef LESSON06_THREAD_POOL_H
+#define LESSON06_THREAD_POOL_H
+
+/*
+ * Пул потоков: рабочие потоки создаются один раз, а задачи передаются им
+ * через общую очередь. Создание std::thread стоит десятки микросекунд, а
+ * передача задачи готовому потоку — порядка микросекунды, поэтому мелкие
+ * задачи выгоднее отдавать пулу, чем запускать каждую в своём потоке.
+ *
+ * submit() возвращает std::future с результатом задачи (или её исключением).
+ * При разрушении пул дорабатывает уже поставленные задачи и только потом
+ * останавливает потоки.
+ */
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class ThreadPool {
+public:
+    // threads == 0 — по числу аппаратных потоков
+    explicit ThreadPool(size_t threads = 0) {
+        if (threads == 0) threads = std::thread::hardware_concurrency();
+        if (threads == 0) threads = 1;
+        for (size_t i = 0; i < threads; ++i) {
+            workers.emplace_back([this] { run(); });
+        }
+    }
+
+    ~ThreadPool() {
+        shutdown();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    template <typename F, typename... Args>
+    auto submit(F&& f, Args&&... args) -> std::future<typename std::invoke_result<F, Args...>::type> {
+        using Result = typename std::invoke_result<F, Args...>::type;
+        // packaged_task нельзя копировать, а std::function требует копируемости,
+        // поэтому задача хранится по shared_ptr
+        auto task = std::make_shared<std::packaged_task<Result()>>(
+            std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+        std::future<Result> result = task->get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping) throw std::runtime_error("ThreadPool: submit() after shutdown()");
+            tasks.emplace([task] { (*task)(); });
+        }
+        wake.notify_one();
+        return result;
+    }
+
+    // Дожидается всех поставленных задач и останавливает потоки
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping) return;
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    void run() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [this] { return stopping || !tasks.empty(); });
+                // Очередь дорабатывается до конца и после shutdown()
+                if (tasks.empty()) return;
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+            task();
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,64 @@
+/*
+ * Сравнение накладных расходов на задачу: новый std::thread на каждую
+ * задачу против отправки задачи в ThreadPool. Задача пустая, поэтому
+ * замеряется только стоимость запуска и ожидания.
+ *
+ * g++ -std=c++17 -O2 -o thread_pool_bench thread_pool_bench.cpp -pthread
+ */
+
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "thread_pool.h"
+
+using Clock = std::chrono::steady_clock;
+
+double nanosecondsPerTask(Clock::time_point start, int tasks) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / tasks;
+}
+
+void emptyTask() {}
+
+// Поток на задачу, как в исходном example_thread_3.cpp
+double threadPerTask(int tasks) {
+    Clock::time_point start = Clock::now();
+    std::vector<std::thread> threads;
+    threads.reserve(tasks);
+    for (int i = 0; i < tasks; ++i) {
+        threads.emplace_back(emptyTask);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return nanosecondsPerTask(start, tasks);
+}
+
+double poolPerTask(ThreadPool& pool, int tasks) {
+    Clock::time_point start = Clock::now();
+    std::vector<std::future<void>> results;
+    results.reserve(tasks);
+    for (int i = 0; i < tasks; ++i) {
+        results.push_back(pool.submit(emptyTask));
+    }
+    for (auto& result : results) {
+        result.get();
+    }
+    return nanosecondsPerTask(start, tasks);
+}
+
+int main() {
+    ThreadPool pool;
+    std::cout << "Потоков в пуле: " << pool.size() << std::endl;
+    std::cout << "задач\tstd::thread, мкс/задачу\tThreadPool, мкс/задачу" << std::endl;
+
+    for (int tasks : {10, 100, 1000, 10000}) {
+        double spawned = threadPerTask(tasks);
+        double pooled = poolPerTask(pool, tasks);
+        std::cout << tasks << "\t" << spawned / 1000 << "\t\t\t" << pooled / 1000 << std::endl;
+    }
+
+    return 0;
+}
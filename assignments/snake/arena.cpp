@@ -0,0 +1,190 @@
+#include "arena.h"
+
+#include <utility>
+
+namespace {
+
+int opposite(int direction) {
+    return (direction + 1) % 4 + 1;
+}
+
+}
+
+Arena::Arena(int width, int height, size_t snakes, size_t players, uint64_t seed, size_t food_count)
+    : width(width), height(height),
+      head_x(snakes), head_y(snakes), tail(snakes), length(snakes), direction(snakes, RIGHT),
+      alive(snakes, 0), bot(snakes, 1), respawn_tick(snakes, 0),
+      owner(width, height, NO_SNAKE), toward_head(width, height), food_at(width, height, -1),
+      food_cell(food_count), rng(seed), tick(0),
+      next_cell(snakes), eats(snakes), dies(snakes),
+      claim_tick(width, height, UINT64_MAX), claim_by(width, height) {
+    for (size_t i = 0; i < snakes; ++i) {
+        if (i < players) bot[i] = 0;
+        if (!spawn(i)) respawn_tick[i] = 1;
+    }
+    for (size_t f = 0; f < food_count; ++f) {
+        placeFood(f);
+    }
+}
+
+size_t Arena::segments() const {
+    size_t total = 0;
+    for (size_t i = 0; i < size(); ++i) {
+        if (alive[i]) total += length[i];
+    }
+    return total;
+}
+
+bool Arena::spawn(size_t i) {
+    for (int attempt = 0; attempt < ARENA_SPAWN_ATTEMPTS; ++attempt) {
+        int x = static_cast<int>(rng.below(width)), y = static_cast<int>(rng.below(height));
+        int d = static_cast<int>(rng.below(4)) + 1;
+        int back = opposite(d);
+        // Тело вытянуто назад от головы; все клетки должны быть свободны
+        uint32_t cells[START_TAIL_SIZE + 1];
+        bool free = true;
+        int cx = x, cy = y;
+        for (int k = 0; k <= START_TAIL_SIZE && free; ++k) {
+            cells[k] = cell(cx, cy);
+            free = owner.cells[cells[k]] == NO_SNAKE && food_at.cells[cells[k]] < 0;
+            for (int j = 0; j < k && free; ++j) free = cells[j] != cells[k];
+            stepCell(cx, cy, back, width, height);
+        }
+        if (!free) continue;
+
+        for (int k = 0; k <= START_TAIL_SIZE; ++k) {
+            owner.cells[cells[k]] = static_cast<uint32_t>(i + 1);
+            if (k) toward_head.cells[cells[k]] = cells[k - 1];
+        }
+        head_x[i] = x;
+        head_y[i] = y;
+        tail[i] = cells[START_TAIL_SIZE];
+        length[i] = START_TAIL_SIZE + 1;
+        direction[i] = static_cast<uint8_t>(d);
+        alive[i] = 1;
+        return true;
+    }
+    return false;
+}
+
+void Arena::placeFood(size_t f) {
+    // Поле арены в основном свободно, поэтому клетка ищется случайной пробой
+    size_t cells = owner.cells.size();
+    for (int attempt = 0; attempt < ARENA_SPAWN_ATTEMPTS; ++attempt) {
+        uint32_t c = static_cast<uint32_t>(rng.below(cells));
+        if (owner.cells[c] != NO_SNAKE || food_at.cells[c] >= 0) continue;
+        food_at.cells[c] = static_cast<int32_t>(f);
+        food_cell[f] = c;
+        return;
+    }
+    food_cell[f] = UINT32_MAX;
+}
+
+int Arena::decide(size_t i) {
+    // Вперёд или поворот; еда важнее всего, изредка поворачиваем без причины
+    int forward = direction[i];
+    int turns[3] = {forward, forward % 4 + 1, (forward + 2) % 4 + 1};
+    bool wander = rng.below(16) == 0;
+    if (wander && rng.below(2)) std::swap(turns[1], turns[2]);
+    int choice = forward;
+    int best = -1;
+    for (int d : turns) {
+        int x = head_x[i], y = head_y[i];
+        stepCell(x, y, d, width, height);
+        uint32_t c = cell(x, y);
+        if (owner.cells[c] != NO_SNAKE) continue;
+        int score = food_at.cells[c] >= 0 ? 4 : (d == forward) != wander ? 2 : 1;
+        if (score > best) {
+            best = score;
+            choice = d;
+        }
+    }
+    return choice;
+}
+
+void Arena::removeBody(size_t i) {
+    uint32_t c = tail[i];
+    uint32_t head = headCell(i);
+    while (true) {
+        owner.cells[c] = NO_SNAKE;
+        if (c == head) break;
+        c = toward_head.cells[c];
+    }
+}
+
+void Arena::step(const int* inputs) {
+    tick++;
+    size_t n = size();
+
+    for (size_t i = 0; i < n; ++i) {
+        if (!alive[i] && respawn_tick[i] && respawn_tick[i] <= tick) {
+            respawn_tick[i] = spawn(i) ? 0 : tick + 1;
+        }
+    }
+
+    // 1) Куда идут головы
+    for (size_t i = 0; i < n; ++i) {
+        if (!alive[i]) continue;
+        int d = bot[i] ? decide(i) : (inputs && inputs[i] ? inputs[i] : direction[i]);
+        direction[i] = static_cast<uint8_t>(d);
+        int x = head_x[i], y = head_y[i];
+        stepCell(x, y, d, width, height);
+        next_cell[i] = cell(x, y);
+        eats[i] = food_at.cells[next_cell[i]] >= 0;
+        dies[i] = 0;
+    }
+
+    // 2) Хвосты тех, кто не растёт, освобождают клетки до проверки столкновений
+    for (size_t i = 0; i < n; ++i) {
+        if (!alive[i] || eats[i]) continue;
+        uint32_t t = tail[i];
+        tail[i] = toward_head.cells[t];
+        owner.cells[t] = NO_SNAKE;
+        length[i]--;
+    }
+
+    // 3) Столкновения: с телами по сетке, лобовые — по отметкам занятых в этом тике клеток
+    for (size_t i = 0; i < n; ++i) {
+        if (!alive[i]) continue;
+        uint32_t c = next_cell[i];
+        if (owner.cells[c] != NO_SNAKE) {
+            dies[i] = 1;
+        } else if (claim_tick.cells[c] == tick) {
+            dies[i] = 1;
+            dies[claim_by.cells[c]] = 1;
+            head_on++;
+        } else {
+            claim_tick.cells[c] = tick;
+            claim_by.cells[c] = static_cast<uint32_t>(i);
+        }
+    }
+
+    // 4) Выжившие продвигаются
+    for (size_t i = 0; i < n; ++i) {
+        if (!alive[i] || dies[i]) continue;
+        uint32_t c = next_cell[i];
+        toward_head.cells[headCell(i)] = c;
+        owner.cells[c] = static_cast<uint32_t>(i + 1);
+        head_x[i] = static_cast<int32_t>(c % width);
+        head_y[i] = static_cast<int32_t>(c / width);
+        length[i]++;
+        if (eats[i]) {
+            // Новое место еде ищется, когда продвинутся все: иначе она могла бы
+            // лечь в клетку, куда следом войдёт ещё не сдвинутая голова
+            food_cell[food_at.cells[c]] = UINT32_MAX;
+            food_at.cells[c] = -1;
+        }
+    }
+    // Съеденная еда и еда, которой прежде не нашлось места, выкладываются заново
+    for (size_t f = 0; f < food_cell.size(); ++f) {
+        if (food_cell[f] == UINT32_MAX) placeFood(f);
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        if (!alive[i] || !dies[i]) continue;
+        removeBody(i);
+        alive[i] = 0;
+        respawn_tick[i] = tick + ARENA_RESPAWN_TICKS;
+        deaths++;
+    }
+}
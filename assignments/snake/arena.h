@@ -0,0 +1,83 @@
+#ifndef SNAKE_ARENA_H
+#define SNAKE_ARENA_H
+
+/*
+ * Арена: десятки и сотни змеек на одном поле. Змейки хранятся не объектами,
+ * а параллельными массивами (голова, хвост, длина, направление...), а их тела
+ * лежат прямо в общей сетке: клетка знает владельца и следующую клетку
+ * в сторону головы. Поэтому сдвиг змейки — O(1) независимо от длины, отдельных
+ * буферов хвоста нет, а столкновения проверяются по той же сетке.
+ *
+ * Тик разрешается одновременно для всех змеек:
+ *   1) каждая выбирает следующую клетку головы;
+ *   2) хвосты тех, кто не ест, освобождают клетки;
+ *   3) голова в занятой клетке — смерть, две головы в одной клетке — смерть обеих;
+ *   4) выжившие продвигаются и едят, тела погибших убираются с поля.
+ * Погибшие змейки появляются снова через ARENA_RESPAWN_TICKS тиков.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "game.h"
+
+enum {ARENA_RESPAWN_TICKS=20, ARENA_SPAWN_ATTEMPTS=64};
+
+class Arena {
+public:
+    static constexpr uint32_t NO_SNAKE = 0;
+
+    int width, height;
+
+    // Состояние змеек; индекс — номер змейки
+    std::vector<int32_t> head_x, head_y;
+    std::vector<uint32_t> tail;
+    std::vector<uint32_t> length;
+    std::vector<uint8_t> direction;
+    std::vector<uint8_t> alive;
+    // 1 — змейкой управляет встроенный бот, 0 — игрок через step()
+    std::vector<uint8_t> bot;
+    std::vector<uint64_t> respawn_tick;
+
+    // Номер змейки + 1 для каждой клетки, NO_SNAKE — клетка свободна
+    Grid<uint32_t> owner;
+    // Для клетки тела — соседняя клетка ближе к голове
+    Grid<uint32_t> toward_head;
+    // Индекс еды в клетке, -1 — еды нет
+    Grid<int32_t> food_at;
+    std::vector<uint32_t> food_cell;
+
+    Random rng;
+    uint64_t tick;
+    // Итоги с начала партии
+    uint64_t deaths = 0;
+    uint64_t head_on = 0;
+
+    // Первые players змеек управляются игроками, остальные — ботами
+    Arena(int width, int height, size_t snakes, size_t players, uint64_t seed = SEED_NUMBER,
+          size_t food_count = MAX_FOOD_SIZE);
+
+    size_t size() const { return alive.size(); }
+    uint32_t cell(int x, int y) const { return static_cast<uint32_t>(owner.index(x, y)); }
+    uint32_t headCell(size_t i) const { return cell(head_x[i], head_y[i]); }
+    // Суммарная длина живых змеек
+    size_t segments() const;
+
+    // inputs[i] — новое направление змейки-игрока i или 0
+    void step(const int* inputs);
+
+private:
+    // Рабочие массивы тика, чтобы не выделять память каждый раз
+    std::vector<uint32_t> next_cell;
+    std::vector<uint8_t> eats, dies;
+    Grid<uint64_t> claim_tick;
+    Grid<uint32_t> claim_by;
+
+    bool spawn(size_t i);
+    int decide(size_t i);
+    void placeFood(size_t f);
+    void removeBody(size_t i);
+};
+
+#endif
@@ -0,0 +1,265 @@
+#include "autopilot.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+const int DIRECTIONS[] = {LEFT, UP, RIGHT, DOWN};
+
+// Как часто (в раскрытых клетках) сверяться с часами
+enum {CLOCK_CHECK_INTERVAL=64};
+
+uint32_t neighbour(const GameState& game, uint32_t cell, int direction) {
+    int x = static_cast<int>(cell % game.width), y = static_cast<int>(cell / game.width);
+    stepCell(x, y, direction, game.width, game.height);
+    return static_cast<uint32_t>(game.occupancy.index(x, y));
+}
+
+bool cellFree(const GameState& game, uint32_t cell) {
+    return game.occupancy.cells[cell] == 0;
+}
+
+int lengthBucket(size_t length) {
+    int k = 63 - __builtin_clzll(length | 1);
+    return k < AutopilotStats::LENGTH_BUCKETS ? k : AutopilotStats::LENGTH_BUCKETS - 1;
+}
+
+}
+
+void AutopilotStats::merge(const AutopilotStats& other) {
+    decisions += other.decisions;
+    searches += other.searches;
+    path_reuses += other.path_reuses;
+    nodes_expanded += other.nodes_expanded;
+    budget_exhausted += other.budget_exhausted;
+    search_resumes += other.search_resumes;
+    unsafe_paths += other.unsafe_paths;
+    search_us_total += other.search_us_total;
+    if (other.search_us_max > search_us_max) search_us_max = other.search_us_max;
+    for (int k = 0; k < LENGTH_BUCKETS; ++k) {
+        search_us_by_length[k] += other.search_us_by_length[k];
+        searches_by_length[k] += other.searches_by_length[k];
+    }
+}
+
+int AutopilotBot::decide(const GameState& game) {
+    stats.decisions++;
+    uint32_t head = static_cast<uint32_t>(game.occupancy.index(game.snake.x, game.snake.y));
+
+    if (pathStillValid(game)) {
+        stats.path_reuses++;
+        int direction = path.back();
+        path.pop_back();
+        path_head = neighbour(game, head, direction);
+        return direction;
+    }
+    path.clear();
+
+    Clock::time_point start = Clock::now();
+    deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::micro>(budget_us));
+    prepare(game);
+
+    int direction = 0;
+    if (searchFood(game)) {
+        uint32_t first = neighbour(game, head, path.back());
+        int safe = tailReachable(game, first);
+        if (safe == 0) {
+            stats.unsafe_paths++;
+            path.clear();
+        } else {
+            direction = path.back();
+            path.pop_back();
+            path_head = first;
+        }
+    }
+    if (!direction) {
+        path.clear();
+        direction = fallback(game);
+    }
+
+    double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    stats.searches++;
+    stats.search_us_total += us;
+    if (us > stats.search_us_max) stats.search_us_max = us;
+    int bucket = lengthBucket(game.snake.tsize);
+    stats.search_us_by_length[bucket] += us;
+    stats.searches_by_length[bucket]++;
+    return direction;
+}
+
+void AutopilotBot::prepare(const GameState& game) {
+    size_t cells = game.occupancy.cells.size();
+    if (visited.size() != cells) {
+        visited.assign(cells, 0);
+        queue.resize(cells);
+        stamp = 0;
+        search_seen.assign(cells, 0);
+        search_dist.assign(cells, 0);
+        toward_food.assign(cells, 0);
+        frontier.resize(cells);
+        search_stamp = 0;
+        search_active = false;
+    }
+}
+
+bool AutopilotBot::pathStillValid(const GameState& game) const {
+    if (path.empty()) return false;
+    uint32_t head = static_cast<uint32_t>(game.occupancy.index(game.snake.x, game.snake.y));
+    if (head != path_head) return false;
+    // Еда, к которой шли, должна лежать на месте, а следующая клетка — быть свободной
+    if (game.food_at.cells[path_target] < 0) return false;
+    return cellFree(game, neighbour(game, head, path.back()));
+}
+
+bool AutopilotBot::searchFood(const GameState& game) {
+    if (searchResumable(game)) stats.search_resumes++;
+    else startSearch(game);
+    bool restarted = false;
+    while (true) {
+        int found = pathFromField(game);
+        if (found > 0) return true;
+        if (found < 0) {
+            // Старые клетки поля устарели; в этом тике поле чистое, так что хватит одного раза
+            if (restarted) return false;
+            restarted = true;
+            startSearch(game);
+            continue;
+        }
+        if (!expandSearch(game)) return false;
+    }
+}
+
+void AutopilotBot::startSearch(const GameState& game) {
+    // Цель — ближайшая еда по манхэттенскому расстоянию с переходом через край
+    size_t target = game.food.size();
+    int best = 0;
+    for (size_t i = 0; i < game.food.size(); ++i) {
+        if (!game.food.enabled(i)) continue;
+        int dx = std::abs(game.food.x[i] - game.snake.x), dy = std::abs(game.food.y[i] - game.snake.y);
+        int d = std::min(dx, game.width - dx) + std::min(dy, game.height - dy);
+        if (target == game.food.size() || d < best) {
+            best = d;
+            target = i;
+        }
+    }
+    ++search_stamp;
+    search_begin = search_end = 0;
+    search_active = target < game.food.size();
+    if (!search_active) return;
+    search_target = static_cast<uint32_t>(game.occupancy.index(game.food.x[target], game.food.y[target]));
+    search_seen[search_target] = search_stamp;
+    search_dist[search_target] = 0;
+    toward_food[search_target] = search_target;
+    frontier[search_end++] = search_target;
+}
+
+bool AutopilotBot::searchResumable(const GameState& game) const {
+    // Еда, от которой идёт поиск, всё ещё на месте
+    return search_active && game.food_at.cells[search_target] >= 0;
+}
+
+int AutopilotBot::pathFromField(const GameState& game) {
+    uint32_t head = static_cast<uint32_t>(game.occupancy.index(game.snake.x, game.snake.y));
+    int first = 0;
+    uint32_t start = 0;
+    for (int direction : DIRECTIONS) {
+        uint32_t next = neighbour(game, head, direction);
+        if (search_seen[next] != search_stamp || !cellFree(game, next)) continue;
+        if (!first || search_dist[next] < search_dist[start]) {
+            first = direction;
+            start = next;
+        }
+    }
+    if (!first) return 0;
+
+    // Направления кладутся в path с конца, поэтому собираем по порядку и разворачиваем
+    path.clear();
+    path.push_back(first);
+    uint32_t cell = start;
+    while (search_dist[cell] != 0) {
+        uint32_t next = toward_food[cell];
+        if (!cellFree(game, next)) {
+            path.clear();
+            return -1;
+        }
+        for (int d : DIRECTIONS) {
+            if (neighbour(game, cell, d) == next) {
+                path.push_back(d);
+                break;
+            }
+        }
+        cell = next;
+    }
+    std::reverse(path.begin(), path.end());
+    path_target = cell;
+    return 1;
+}
+
+bool AutopilotBot::expandSearch(const GameState& game) {
+    uint32_t head = static_cast<uint32_t>(game.occupancy.index(game.snake.x, game.snake.y));
+    while (search_begin < search_end) {
+        if (search_begin % CLOCK_CHECK_INTERVAL == 0 && outOfBudget()) {
+            stats.budget_exhausted++;
+            return false;
+        }
+        uint32_t cell = frontier[search_begin++];
+        // С прошлых тиков клетку могла занять змейка: через неё пути уже нет
+        if (!cellFree(game, cell)) continue;
+        stats.nodes_expanded++;
+        bool reached = false;
+        for (int direction : DIRECTIONS) {
+            uint32_t next = neighbour(game, cell, direction);
+            if (next == head) reached = true;
+            if (search_seen[next] == search_stamp || !cellFree(game, next)) continue;
+            search_seen[next] = search_stamp;
+            search_dist[next] = search_dist[cell] + 1;
+            toward_food[next] = cell;
+            frontier[search_end++] = next;
+        }
+        // Клетка рядом с головой раскрыта: путь можно собирать
+        if (reached) return true;
+    }
+    // До головы не дойти; в следующем тике поиск начнётся заново
+    search_active = false;
+    return false;
+}
+
+int AutopilotBot::tailReachable(const GameState& game, uint32_t from) {
+    Tail tip = game.snake.segment(game.snake.tsize - 1);
+    uint32_t target = static_cast<uint32_t>(game.occupancy.index(tip.x, tip.y));
+    ++stamp;
+    size_t begin = 0, end = 0;
+    visited[from] = stamp;
+    queue[end++] = from;
+
+    while (begin < end) {
+        uint32_t cell = queue[begin++];
+        stats.nodes_expanded++;
+        if (begin % CLOCK_CHECK_INTERVAL == 0 && outOfBudget()) {
+            stats.budget_exhausted++;
+            return -1;
+        }
+        for (int direction : DIRECTIONS) {
+            uint32_t next = neighbour(game, cell, direction);
+            if (next == target) return 1;
+            if (visited[next] == stamp || !cellFree(game, next)) continue;
+            visited[next] = stamp;
+            queue[end++] = next;
+        }
+    }
+    return 0;
+}
+
+int AutopilotBot::fallback(const GameState& game) {
+    // Без пути к еде: идём туда, откуда виден хвост, а если такого хода нет — куда угодно свободно
+    uint32_t head = static_cast<uint32_t>(game.occupancy.index(game.snake.x, game.snake.y));
+    int any_free = 0;
+    for (int direction : DIRECTIONS) {
+        uint32_t next = neighbour(game, head, direction);
+        if (!cellFree(game, next)) continue;
+        if (!any_free) any_free = direction;
+        if (outOfBudget() || tailReachable(game, next) != 0) return direction;
+    }
+    return any_free;
+}
@@ -0,0 +1,95 @@
+#ifndef SNAKE_AUTOPILOT_H
+#define SNAKE_AUTOPILOT_H
+
+/*
+ * Автопилот: поиск в ширину к ближайшей еде с проверкой, что после
+ * первого шага до кончика хвоста ещё можно дойти (иначе змейка запрёт себя).
+ * Найденный путь переиспользуется в следующих тиках, пока он остаётся
+ * верным, а каждый поиск укладывается в заданный бюджет микросекунд.
+ *
+ * Поиск идёт не от головы, а от ближайшей еды к голове: еда от тика к тику
+ * не двигается, поэтому поиск, не уложившийся в бюджет, продолжается в
+ * следующем тике с того же фронта, пока эта еда на месте. Клетки, которые
+ * за это время заняла змейка, отсеиваются при раскрытии и сборке пути.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "bot.h"
+
+enum {AUTOPILOT_BUDGET_US=500};
+
+struct AutopilotStats {
+    enum {LENGTH_BUCKETS=32};
+
+    uint64_t decisions = 0;
+    uint64_t searches = 0;
+    uint64_t path_reuses = 0;
+    uint64_t nodes_expanded = 0;
+    uint64_t budget_exhausted = 0;
+    // Поиски, продолженные с фронта прошлых тиков
+    uint64_t search_resumes = 0;
+    uint64_t unsafe_paths = 0;
+    double search_us_total = 0;
+    double search_us_max = 0;
+    // Время поисков по длине змейки: корзина k — длины [2^k, 2^(k+1))
+    double search_us_by_length[LENGTH_BUCKETS] = {};
+    uint64_t searches_by_length[LENGTH_BUCKETS] = {};
+
+    void merge(const AutopilotStats& other);
+};
+
+class AutopilotBot : public Bot {
+public:
+    // Бюджет на все поиски за один тик
+    double budget_us = AUTOPILOT_BUDGET_US;
+    AutopilotStats stats;
+
+    int decide(const GameState& game) override;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Буферы проверки хвоста; visited сбрасывается сменой метки, без очистки
+    std::vector<uint32_t> visited;
+    std::vector<uint32_t> queue;
+    uint32_t stamp = 0;
+
+    // Поиск от еды, который переживает тики: отметки, расстояние до еды,
+    // следующая клетка в сторону еды и фронт (frontier[search_begin, search_end))
+    std::vector<uint32_t> search_seen;
+    std::vector<uint32_t> search_dist;
+    std::vector<uint32_t> toward_food;
+    std::vector<uint32_t> frontier;
+    size_t search_begin = 0, search_end = 0;
+    uint32_t search_stamp = 0;
+    bool search_active = false;
+    // Клетка еды, от которой идёт поиск
+    uint32_t search_target = 0;
+
+    // Запомненный путь: направления с конца вектора, ожидаемая голова и цель
+    std::vector<int> path;
+    uint32_t path_head = 0;
+    uint32_t path_target = 0;
+
+    Clock::time_point deadline;
+
+    void prepare(const GameState& game);
+    bool pathStillValid(const GameState& game) const;
+    bool searchFood(const GameState& game);
+    void startSearch(const GameState& game);
+    bool searchResumable(const GameState& game) const;
+    // 1 — путь от соседа головы до еды собран в path, 0 — голова ещё не
+    // достигнута, -1 — путь прошёл бы через клетку, которую уже заняла змейка
+    int pathFromField(const GameState& game);
+    // false — бюджет кончился или фронт исчерпан
+    bool expandSearch(const GameState& game);
+    // 1 — хвост достижим, 0 — нет, -1 — не успели проверить за бюджет
+    int tailReachable(const GameState& game, uint32_t from);
+    int fallback(const GameState& game);
+    bool outOfBudget() const { return Clock::now() > deadline; }
+};
+
+#endif
@@ -0,0 +1,187 @@
+/*
+ * snake_batch — прогон множества партий без терминала.
+ * Каждая партия получает своё зерно и своего бота; партии раздаются
+ * рабочим пула с кражей работы.
+ *
+ * ./snake_batch [--games N] [--width W] [--height H] [--bots greedy,random,autopilot,flood]
+ *               [--max-ticks T] [--threads K] [--seed S] [--budget-us B]
+ *               [--record-dir каталог] [--lookup grid|scan]
+ *
+ * Бот flood собран только для поля 20x20.
+ * --lookup scan ищет столкновения и еду просмотром массивов SIMD-ядрами
+ * (GameState::scan_lookups); счёт партий при этом тот же, что и с grid.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "autopilot.h"
+#include "bot.h"
+#include "game.h"
+#include "replay.h"
+#include "stats.h"
+#include "work_pool.h"
+
+using Clock = std::chrono::steady_clock;
+
+struct GameResult {
+    size_t bot;
+    size_t score;
+    uint64_t ticks;
+};
+
+int main(int argc, char* argv[]) {
+    size_t games = 1000;
+    int width = 40, height = 20;
+    std::string bot_list = "greedy,random";
+    uint64_t max_ticks = 10000;
+    size_t threads = 0;
+    uint64_t seed = SEED_NUMBER;
+    double budget_us = AUTOPILOT_BUDGET_US;
+    std::string record_dir;
+    std::string lookup = "grid";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--games") == 0) games = strtoull(argv[i + 1], nullptr, 10);
+        else if (strcmp(argv[i], "--width") == 0) width = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--height") == 0) height = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--bots") == 0) bot_list = argv[i + 1];
+        else if (strcmp(argv[i], "--max-ticks") == 0) max_ticks = strtoull(argv[i + 1], nullptr, 10);
+        else if (strcmp(argv[i], "--threads") == 0) threads = strtoull(argv[i + 1], nullptr, 10);
+        else if (strcmp(argv[i], "--seed") == 0) seed = strtoull(argv[i + 1], nullptr, 10);
+        else if (strcmp(argv[i], "--budget-us") == 0) budget_us = atof(argv[i + 1]);
+        else if (strcmp(argv[i], "--record-dir") == 0) record_dir = argv[i + 1];
+        else if (strcmp(argv[i], "--lookup") == 0) lookup = argv[i + 1];
+    }
+    if (width <= START_TAIL_SIZE || height <= 1 || width > MAX_BOARD_SIDE || height > MAX_BOARD_SIDE) {
+        fprintf(stderr, "Unsupported board size: %dx%d\n", width, height);
+        return 1;
+    }
+    if (lookup != "grid" && lookup != "scan") {
+        fprintf(stderr, "--lookup expects grid or scan\n");
+        return 1;
+    }
+    bool scan_lookups = lookup == "scan";
+
+    // Боты назначаются партиям по кругу в порядке из --bots
+    std::vector<std::string> bots;
+    std::stringstream names(bot_list);
+    for (std::string name; std::getline(names, name, ',');) {
+        if (!makeBot(name, 0, width, height)) {
+            fprintf(stderr, "Unknown bot: %s (flood needs a %dx%d board)\n", name.c_str(),
+                    FLOOD_BOARD_SIDE, FLOOD_BOARD_SIDE);
+            return 1;
+        }
+        bots.push_back(name);
+    }
+    if (bots.empty()) {
+        fprintf(stderr, "No bots given\n");
+        return 1;
+    }
+
+    std::vector<GameResult> results(games);
+    Histogram tick_ns;
+    AutopilotStats autopilot;
+    std::mutex merge_mutex;
+    std::atomic<size_t> record_failures(0);
+
+    Clock::time_point start = Clock::now();
+    {
+        WorkStealingPool pool(threads);
+        threads = pool.size();
+        for (size_t g = 0; g < games; ++g) {
+            pool.submit([&, g] {
+                uint64_t game_seed = seed + g;
+                size_t bot_index = g % bots.size();
+                std::unique_ptr<Bot> bot = makeBot(bots[bot_index], game_seed, width, height);
+                AutopilotBot* pilot = dynamic_cast<AutopilotBot*>(bot.get());
+                if (pilot) pilot->budget_us = budget_us;
+                GameState game(width, height, game_seed);
+                game.scan_lookups = scan_lookups;
+                Histogram local;
+                ReplayWriter recorder;
+                if (!record_dir.empty()) {
+                    std::string path = record_dir + "/game_" + std::to_string(g) + ".snkr";
+                    if (!recorder.open(path, game, game_seed)) record_failures++;
+                }
+
+                Clock::time_point last = Clock::now();
+                while (game.tick < max_ticks) {
+                    int input = bot->decide(game);
+                    recorder.record(game, input);
+                    StepResult result = game.step(input);
+                    Clock::time_point now = Clock::now();
+                    local.add(std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count());
+                    last = now;
+                    if (result == STEP_CRASHED) break;
+                }
+
+                if (recorder.isOpen() && !recorder.close(game)) record_failures++;
+                results[g] = {bot_index, game.snake.tsize, game.tick};
+                std::lock_guard<std::mutex> lock(merge_mutex);
+                tick_ns.merge(local);
+                if (pilot) autopilot.merge(pilot->stats);
+            });
+        }
+        pool.wait();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (record_failures) fprintf(stderr, "Failed to write %zu replays to %s\n", record_failures.load(), record_dir.c_str());
+
+    uint64_t total_ticks = 0;
+    for (const auto& r : results) total_ticks += r.ticks;
+
+    if (scan_lookups) lookup += std::string(" (") + simdLevel() + ")";
+    printf("games: %zu on %zu threads, board %dx%d, max ticks %llu, lookup %s\n",
+           games, threads, width, height, static_cast<unsigned long long>(max_ticks), lookup.c_str());
+    printf("time: %.3f s, %.1f games/s, %.2f M ticks/s\n",
+           seconds, games / seconds, total_ticks / seconds / 1e6);
+    printf("tick time: p50=%llu ns p99=%llu ns p99.9=%llu ns\n",
+           static_cast<unsigned long long>(tick_ns.percentile(50)),
+           static_cast<unsigned long long>(tick_ns.percentile(99)),
+           static_cast<unsigned long long>(tick_ns.percentile(99.9)));
+    for (size_t b = 0; b < bots.size(); ++b) {
+        size_t played = 0, best = 0;
+        double score = 0, ticks = 0;
+        for (const auto& r : results) {
+            if (r.bot != b) continue;
+            played++;
+            score += r.score;
+            ticks += r.ticks;
+            if (r.score > best) best = r.score;
+        }
+        if (played) {
+            printf("%-8s games=%-7zu mean score=%.2f max score=%zu mean ticks=%.0f\n",
+                   bots[b].c_str(), played, score / played, best, ticks / played);
+        }
+    }
+
+    if (autopilot.decisions) {
+        const AutopilotStats& a = autopilot;
+        double searches = a.searches ? a.searches : 1;
+        printf("autopilot: budget %.0f us, %llu decisions, %.1f%% path reuse, %llu searches (%llu resumed)\n",
+               budget_us, static_cast<unsigned long long>(a.decisions),
+               100.0 * a.path_reuses / a.decisions, static_cast<unsigned long long>(a.searches),
+               static_cast<unsigned long long>(a.search_resumes));
+        printf("  search: mean %.2f us, max %.2f us, %.0f nodes/search, budget exhausted %llu, unsafe paths %llu\n",
+               a.search_us_total / searches, a.search_us_max, a.nodes_expanded / searches,
+               static_cast<unsigned long long>(a.budget_exhausted), static_cast<unsigned long long>(a.unsafe_paths));
+        for (int k = 0; k < AutopilotStats::LENGTH_BUCKETS; ++k) {
+            if (!a.searches_by_length[k]) continue;
+            printf("  length %7llu+: %9llu searches, mean %.2f us\n",
+                   1ULL << k, static_cast<unsigned long long>(a.searches_by_length[k]),
+                   a.search_us_by_length[k] / a.searches_by_length[k]);
+        }
+    }
+
+    return 0;
+}
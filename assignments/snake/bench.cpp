@@ -0,0 +1,387 @@
+/*
+ * snake_bench — микробенчмарки игрового тика на Google Benchmark.
+ * Отдельно замеряются шаги тика (move, moveTail, isCrash, haveEat,
+ * refreshFood, putFoodSeed), тик целиком и снимки состояния; длина змейки,
+ * число еды и размер поля перебираются параметрами. Ядра findCell из simd.h
+ * замеряются по отдельности и перед замером сверяются со скалярным, битовое
+ * поле Board<20, 20> — с сетками GameState.
+ *
+ * ./snake_bench --benchmark_format=json --benchmark_out=bench.json
+ * ./snake_bench --benchmark_filter=Tick
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "bitboard.h"
+#include "game.h"
+#include "simd.h"
+
+namespace {
+
+const uint64_t BENCH_SEED = 42;
+
+// Поле обходится «змейкой»: чётные строки слева направо, нечётные справа
+// налево, из конца строки вниз. При чётной высоте последний шаг вниз
+// переходит через край в начало, так что обход замкнут.
+void pathCell(int width, size_t k, int& x, int& y) {
+    y = static_cast<int>(k / width);
+    int col = static_cast<int>(k % width);
+    x = (y % 2 == 0) ? col : width - 1 - col;
+}
+
+int pathDirection(int width, int x, int y) {
+    int col = (y % 2 == 0) ? x : width - 1 - x;
+    if (col == width - 1) return DOWN;
+    return (y % 2 == 0) ? RIGHT : LEFT;
+}
+
+// Партия со змейкой длины length, уложенной вдоль обхода от клетки 0;
+// голова смотрит вдоль обхода, так что тики по pathDirection не разбивают её
+GameState makeGame(int side, size_t length, size_t food_count) {
+    GameState game(side, side, BENCH_SEED, food_count);
+    std::fill(game.occupancy.cells.begin(), game.occupancy.cells.end(), 0);
+    std::fill(game.food_at.cells.begin(), game.food_at.cells.end(), -1);
+    game.free_cells.fill();
+    game.food.clear();
+    for (auto& slot : game.expiry_wheel) slot.clear();
+
+    size_t capacity = START_TAIL_CAPACITY;
+    while (capacity < length) capacity *= 2;
+    game.snake.tail_x.assign(capacity, 0);
+    game.snake.tail_y.assign(capacity, 0);
+    game.snake.head = 0;
+    game.snake.tsize = length;
+    for (size_t i = 0; i < length; ++i) {
+        int x, y;
+        pathCell(side, length - 1 - i, x, y);
+        game.snake.tail_x[i] = static_cast<uint16_t>(x);
+        game.snake.tail_y[i] = static_cast<uint16_t>(y);
+        game.occupancy.at(x, y)++;
+        game.free_cells.erase(static_cast<uint32_t>(game.occupancy.index(x, y)));
+    }
+    game.snake.x = game.snake.tail_x[0];
+    game.snake.y = game.snake.tail_y[0];
+    game.snake.direction = pathDirection(side, game.snake.x, game.snake.y);
+    game.putFood();
+    game.changed.clear();
+    return game;
+}
+
+// Аргументы: длина змейки, сторона поля, число еды. Змейка занимает не больше
+// половины поля, чтобы ей было куда расти во время замера.
+void sweep(benchmark::internal::Benchmark* b) {
+    for (int64_t length : {10, 100, 1000, 10000, 100000}) {
+        for (int64_t side : {64, 256, 512}) {
+            if (length * 2 > side * side) continue;
+            for (int64_t food : {20, 1000}) b->Args({length, side, food});
+        }
+    }
+}
+
+void BM_Move(benchmark::State& state) {
+    GameState game = makeGame(static_cast<int>(state.range(1)), state.range(0), MAX_FOOD_SIZE);
+    for (auto _ : state) {
+        game.snake.move(game.width, game.height);
+        benchmark::DoNotOptimize(game.snake.x);
+    }
+}
+BENCHMARK(BM_Move)->Args({10, 64});
+
+void BM_MoveTail(benchmark::State& state) {
+    GameState game = makeGame(static_cast<int>(state.range(1)), state.range(0), MAX_FOOD_SIZE);
+    for (auto _ : state) {
+        game.snake.moveTail();
+        benchmark::DoNotOptimize(game.snake.head);
+    }
+}
+BENCHMARK(BM_MoveTail)->Args({10, 64})->Args({100000, 512});
+
+// Голова перебирает заранее выбранные случайные клетки, так что промахи кэша
+// по сетке занятости видны на больших полях
+void BM_IsCrash(benchmark::State& state) {
+    GameState game = makeGame(static_cast<int>(state.range(1)), state.range(0), MAX_FOOD_SIZE);
+    Random rng(BENCH_SEED);
+    std::vector<uint32_t> cells(4096);
+    for (auto& c : cells) c = static_cast<uint32_t>(rng.below(game.occupancy.cells.size()));
+    size_t k = 0;
+    for (auto _ : state) {
+        uint32_t c = cells[k++ & (cells.size() - 1)];
+        game.snake.x = static_cast<int>(c % game.width);
+        game.snake.y = static_cast<int>(c / game.width);
+        benchmark::DoNotOptimize(game.isCrash());
+    }
+}
+BENCHMARK(BM_IsCrash)->Args({1000, 64})->Args({1000, 512})->Args({100000, 512});
+
+// Голова в клетке без еды: только поиск по food_at
+void BM_HaveEatMiss(benchmark::State& state) {
+    GameState game = makeGame(static_cast<int>(state.range(1)), state.range(0), state.range(2));
+    game.snake.x = game.snake.tail_x[1];
+    game.snake.y = game.snake.tail_y[1];
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(game.haveEat());
+    }
+}
+BENCHMARK(BM_HaveEatMiss)->Args({10, 64, 20});
+
+// Голова на еде: еда съедается и в том же тике выкладывается заново.
+// Змейка в клетку с едой на самом деле не входит, поэтому клетка сразу
+// возвращается в свободные — иначе каждая итерация теряла бы по клетке,
+// пока еде не станет некуда лечь.
+void BM_HaveEatHit(benchmark::State& state) {
+    GameState game = makeGame(static_cast<int>(state.range(1)), state.range(0), state.range(2));
+    size_t i = 0;
+    for (auto _ : state) {
+        game.snake.x = game.food.x[i];
+        game.snake.y = game.food.y[i];
+        benchmark::DoNotOptimize(game.haveEat());
+        game.free_cells.insert(static_cast<uint32_t>(game.occupancy.index(game.snake.x, game.snake.y)));
+        game.refreshFood();
+        game.changed.clear();
+        if (++i == game.food.size()) i = 0;
+    }
+}
+BENCHMARK(BM_HaveEatHit)->Apply(sweep);
+
+// Тик за тиком протухает примерно food / FOOD_EXPIRE_TICKS еды
+void BM_RefreshFood(benchmark::State& state) {
+    GameState game = makeGame(static_cast<int>(state.range(1)), state.range(0), state.range(2));
+    for (auto _ : state) {
+        game.tick++;
+        game.refreshFood();
+        game.changed.clear();
+    }
+}
+BENCHMARK(BM_RefreshFood)->Apply(sweep);
+
+// Замена repairSeed(): выбор свободной клетки для еды (см. FreeCells)
+void BM_PutFoodSeed(benchmark::State& state) {
+    GameState game = makeGame(static_cast<int>(state.range(1)), state.range(0), state.range(2));
+    size_t i = 0;
+    for (auto _ : state) {
+        game.putFoodSeed(i);
+        if (++i == game.food.size()) {
+            // Таймеры здесь не обрабатываются, поэтому колесо чистим вручную
+            i = 0;
+            for (auto& slot : game.expiry_wheel) slot.clear();
+            game.changed.clear();
+        }
+    }
+}
+BENCHMARK(BM_PutFoodSeed)->Apply(sweep);
+
+// Тик целиком. Змейка идёт по замкнутому обходу и растёт от еды; когда она
+// вырастает вдвое, партия возвращается к исходному снимку вне замера.
+void BM_Tick(benchmark::State& state) {
+    size_t length = state.range(0);
+    GameState game = makeGame(static_cast<int>(state.range(1)), length, state.range(2));
+    GameSnapshot start = game.fork();
+    for (auto _ : state) {
+        StepResult result = game.step(pathDirection(game.width, game.snake.x, game.snake.y));
+        if (result == STEP_CRASHED || game.snake.tsize >= 2 * length) {
+            state.PauseTiming();
+            game.restore(start);
+            state.ResumeTiming();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Tick)->Apply(sweep);
+
+void BM_SnapshotSave(benchmark::State& state) {
+    GameState game = makeGame(static_cast<int>(state.range(1)), state.range(0), state.range(2));
+    GameSnapshot snapshot;
+    for (auto _ : state) {
+        game.save(snapshot);
+        benchmark::DoNotOptimize(snapshot.bytes.data());
+    }
+    state.SetBytesProcessed(state.iterations() * snapshot.size());
+}
+BENCHMARK(BM_SnapshotSave)->Args({10, 64, 20})->Args({1000, 256, 20})->Args({100000, 512, 20});
+
+void BM_SnapshotRestore(benchmark::State& state) {
+    GameState game = makeGame(static_cast<int>(state.range(1)), state.range(0), state.range(2));
+    GameSnapshot snapshot = game.fork();
+    for (auto _ : state) {
+        game.restore(snapshot);
+        benchmark::DoNotOptimize(game.tick);
+    }
+    state.SetBytesProcessed(state.iterations() * snapshot.size());
+}
+BENCHMARK(BM_SnapshotRestore)->Args({10, 64, 20})->Args({1000, 256, 20})->Args({100000, 512, 20});
+
+using FindCellFn = size_t (*)(const uint16_t*, const uint16_t*, size_t, uint16_t, uint16_t);
+
+// Уровни по возрастанию; вариант можно звать, если он не выше выбранного для findCell
+bool kernelSupported(const char* level) {
+    const char* levels[] = {"scalar", "sse2", "avx2"};
+    int wanted = 0, best = 0;
+    for (int k = 0; k < 3; ++k) {
+        if (strcmp(levels[k], level) == 0) wanted = k;
+        if (strcmp(levels[k], simdLevel()) == 0) best = k;
+    }
+    return wanted <= best;
+}
+
+// Аргумент — число координат. Ищется клетка в случайном месте массива или
+// отсутствующая; до замера ответы ядра сверяются со скалярным на тех же запросах.
+void BM_FindCell(benchmark::State& state, const char* level, FindCellFn find) {
+    if (!kernelSupported(level)) {
+        state.SkipWithError("kernel is not supported by this CPU");
+        return;
+    }
+    size_t n = state.range(0);
+    Random rng(BENCH_SEED);
+    std::vector<uint16_t> xs(n), ys(n);
+    for (size_t i = 0; i < n; ++i) {
+        xs[i] = static_cast<uint16_t>(rng.below(512));
+        ys[i] = static_cast<uint16_t>(rng.below(512));
+    }
+    std::vector<uint16_t> qx(1024), qy(1024);
+    for (size_t k = 0; k < qx.size(); ++k) {
+        size_t i = rng.below(n + n / 4 + 1);
+        qx[k] = i < n ? xs[i] : static_cast<uint16_t>(512 + k);
+        qy[k] = i < n ? ys[i] : 0;
+    }
+    for (size_t k = 0; k < qx.size(); ++k) {
+        for (size_t len : {n, n / 2, n / 3 + 1}) {
+            if (len > n) continue;
+            if (find(xs.data(), ys.data(), len, qx[k], qy[k]) != findCellScalar(xs.data(), ys.data(), len, qx[k], qy[k])) {
+                state.SkipWithError("kernel disagrees with findCellScalar");
+                return;
+            }
+        }
+    }
+
+    size_t k = 0;
+    for (auto _ : state) {
+        size_t q = k++ & (qx.size() - 1);
+        benchmark::DoNotOptimize(find(xs.data(), ys.data(), n, qx[q], qy[q]));
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_CAPTURE(BM_FindCell, scalar, "scalar", findCellScalar)->RangeMultiplier(4)->Range(16, 65536);
+BENCHMARK_CAPTURE(BM_FindCell, sse2, "sse2", findCellSse2)->RangeMultiplier(4)->Range(16, 65536);
+BENCHMARK_CAPTURE(BM_FindCell, avx2, "avx2", findCellAvx2)->RangeMultiplier(4)->Range(16, 65536);
+
+// Тик с поиском столкновения и еды просмотром массивов (GameState::scan_lookups)
+// вместо сеток — сравнивать с BM_Tick на тех же аргументах
+void BM_TickScan(benchmark::State& state) {
+    size_t length = state.range(0);
+    GameState game = makeGame(static_cast<int>(state.range(1)), length, state.range(2));
+    game.scan_lookups = true;
+    GameSnapshot start = game.fork();
+    for (auto _ : state) {
+        StepResult result = game.step(pathDirection(game.width, game.snake.x, game.snake.y));
+        if (result == STEP_CRASHED || game.snake.tsize >= 2 * length) {
+            state.PauseTiming();
+            game.restore(start);
+            state.ResumeTiming();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TickScan)->Args({10, 64, 20})->Args({100, 64, 20})->Args({1000, 64, 20})->Args({1000, 256, 1000});
+
+const int BOARD_SIDE = 20;
+using SmallBoard = Board<BOARD_SIDE, BOARD_SIDE>;
+
+// Клетки, достижимые из (x, y) по свободным клеткам сетки занятости (поиск в ширину)
+SmallBoard::Bits reachableByGrid(const GameState& game, int x, int y) {
+    SmallBoard::Bits seen;
+    std::vector<int> queue = {y * BOARD_SIDE + x};
+    seen.set(x, y);
+    for (size_t k = 0; k < queue.size(); ++k) {
+        for (int direction = LEFT; direction <= DOWN; ++direction) {
+            int nx = queue[k] % BOARD_SIDE, ny = queue[k] / BOARD_SIDE;
+            stepCell(nx, ny, direction, BOARD_SIDE, BOARD_SIDE);
+            if (seen.test(nx, ny) || !game.isFree(nx, ny)) continue;
+            seen.set(nx, ny);
+            queue.push_back(ny * BOARD_SIDE + nx);
+        }
+    }
+    return seen;
+}
+
+// Партия 20x20 идёт по обходу; поле, которое ведёт sync(), должно совпадать
+// с заново собранным load(), а reachable() — с поиском по сетке
+bool boardMatchesGame(GameState game, uint64_t ticks) {
+    GameSnapshot start = game.fork();
+    size_t length = game.snake.tsize;
+    SmallBoard board, fresh;
+    board.load(game);
+    for (uint64_t t = 0; t < ticks; ++t) {
+        StepResult result = game.step(pathDirection(game.width, game.snake.x, game.snake.y));
+        if (result == STEP_CRASHED || game.snake.tsize >= 2 * length) {
+            game.restore(start);
+            board.load(game);
+            continue;
+        }
+        board.sync(game);
+        fresh.load(game);
+        if (board.occupancy != fresh.occupancy || board.food != fresh.food) return false;
+        int x = game.snake.x, y = game.snake.y;
+        stepCell(x, y, pathDirection(game.width, x, y), game.width, game.height);
+        if (game.isFree(x, y) && board.reachable(x, y) != reachableByGrid(game, x, y)) return false;
+    }
+    return true;
+}
+
+// Аргумент — длина змейки на поле 20x20. Тик вместе с переносом его изменений
+// в битовое поле; сравнивать с BM_Tick/длина/64/20
+void BM_BoardSync(benchmark::State& state) {
+    size_t length = state.range(0);
+    GameState game = makeGame(BOARD_SIDE, length, MAX_FOOD_SIZE);
+    if (!boardMatchesGame(game, 20000)) {
+        state.SkipWithError("Board<20, 20> disagrees with GameState");
+        return;
+    }
+    GameSnapshot start = game.fork();
+    SmallBoard board;
+    board.load(game);
+    for (auto _ : state) {
+        StepResult result = game.step(pathDirection(game.width, game.snake.x, game.snake.y));
+        if (result == STEP_CRASHED || game.snake.tsize >= 2 * length) {
+            state.PauseTiming();
+            game.restore(start);
+            board.load(game);
+            state.ResumeTiming();
+        }
+        board.sync(game);
+        benchmark::DoNotOptimize(board.occupancy.words.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BoardSync)->Arg(10)->Arg(100);
+
+// Полная сборка поля из GameState — то, чего sync() избегает между тиками
+void BM_BoardLoad(benchmark::State& state) {
+    GameState game = makeGame(BOARD_SIDE, state.range(0), MAX_FOOD_SIZE);
+    SmallBoard board;
+    for (auto _ : state) {
+        board.load(game);
+        benchmark::DoNotOptimize(board.occupancy.words.data());
+    }
+}
+BENCHMARK(BM_BoardLoad)->Arg(10)->Arg(100);
+
+// Заливка области, достижимой из клетки перед головой
+void BM_BoardReachable(benchmark::State& state) {
+    GameState game = makeGame(BOARD_SIDE, state.range(0), MAX_FOOD_SIZE);
+    SmallBoard board;
+    board.load(game);
+    int x = game.snake.x, y = game.snake.y;
+    stepCell(x, y, pathDirection(game.width, x, y), game.width, game.height);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(board.reachable(x, y).count());
+    }
+}
+BENCHMARK(BM_BoardReachable)->Arg(10)->Arg(100);
+
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,172 @@
+#ifndef SNAKE_BITBOARD_H
+#define SNAKE_BITBOARD_H
+
+/*
+ * Битовое поле для маленьких досок, размер которых известен при компиляции
+ * (например 20x20 для обучения ботов). Клетка (x, y) — бит номер y * W + x.
+ * Змейка и еда хранятся упакованными в 64-битные слова, поэтому проверка
+ * столкновения — один бит, а заливка достижимой области идёт сразу по всем
+ * клеткам слова.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "game.h"
+
+// Слова маски поля W x H: все клетки (x < 0) или только столбец x
+template <int W, int H>
+constexpr std::array<uint64_t, (W * H + 63) / 64> bitGridMask(int x) {
+    std::array<uint64_t, (W * H + 63) / 64> m{};
+    for (int c = 0; c < W * H; ++c) {
+        if (x < 0 || c % W == x) m[c >> 6] |= uint64_t(1) << (c & 63);
+    }
+    return m;
+}
+
+template <int W, int H>
+class BitGrid {
+public:
+    static constexpr int CELLS = W * H;
+    static constexpr int WORDS = (CELLS + 63) / 64;
+    using Words = std::array<uint64_t, WORDS>;
+
+    // Маски считаются при компиляции, поэтому сдвиги не платят за проверку статиков
+    static constexpr Words ALL = bitGridMask<W, H>(-1);
+    static constexpr Words FIRST_COLUMN = bitGridMask<W, H>(0);
+    static constexpr Words LAST_COLUMN = bitGridMask<W, H>(W - 1);
+
+    Words words{};
+
+    static int cell(int x, int y) { return y * W + x; }
+
+    bool test(int x, int y) const { return testCell(cell(x, y)); }
+    void set(int x, int y) { setCell(cell(x, y)); }
+    void reset(int x, int y) { resetCell(cell(x, y)); }
+
+    bool testCell(int c) const { return (words[c >> 6] >> (c & 63)) & 1; }
+    void setCell(int c) { words[c >> 6] |= uint64_t(1) << (c & 63); }
+    void resetCell(int c) { words[c >> 6] &= ~(uint64_t(1) << (c & 63)); }
+
+    bool none() const {
+        uint64_t any = 0;
+        for (uint64_t w : words) any |= w;
+        return any == 0;
+    }
+
+    int count() const {
+        int n = 0;
+        for (uint64_t w : words) n += __builtin_popcountll(w);
+        return n;
+    }
+
+    BitGrid operator|(const BitGrid& o) const { BitGrid r; for (int i = 0; i < WORDS; ++i) r.words[i] = words[i] | o.words[i]; return r; }
+    BitGrid operator&(const BitGrid& o) const { BitGrid r; for (int i = 0; i < WORDS; ++i) r.words[i] = words[i] & o.words[i]; return r; }
+    BitGrid operator^(const BitGrid& o) const { BitGrid r; for (int i = 0; i < WORDS; ++i) r.words[i] = words[i] ^ o.words[i]; return r; }
+    BitGrid operator~() const { BitGrid r; for (int i = 0; i < WORDS; ++i) r.words[i] = ~words[i] & ALL[i]; return r; }
+    bool operator==(const BitGrid& o) const { return words == o.words; }
+    bool operator!=(const BitGrid& o) const { return words != o.words; }
+
+    // Только клетки маски m / всё, кроме клеток маски m
+    BitGrid masked(const Words& m) const { BitGrid r; for (int i = 0; i < WORDS; ++i) r.words[i] = words[i] & m[i]; return r; }
+    BitGrid cleared(const Words& m) const { BitGrid r; for (int i = 0; i < WORDS; ++i) r.words[i] = words[i] & ~m[i]; return r; }
+
+    // Сдвиг всех бит к старшим (k > 0) номерам клеток; выпавшие биты теряются
+    BitGrid shiftUp(int k) const {
+        BitGrid r;
+        int word_shift = k >> 6, bit_shift = k & 63;
+        for (int i = WORDS - 1; i >= word_shift; --i) {
+            uint64_t w = words[i - word_shift] << bit_shift;
+            if (bit_shift && i - word_shift > 0) w |= words[i - word_shift - 1] >> (64 - bit_shift);
+            r.words[i] = w;
+        }
+        return r.masked(ALL);
+    }
+
+    // Сдвиг всех бит к младшим номерам клеток
+    BitGrid shiftDown(int k) const {
+        BitGrid r;
+        int word_shift = k >> 6, bit_shift = k & 63;
+        for (int i = 0; i + word_shift < WORDS; ++i) {
+            uint64_t w = words[i + word_shift] >> bit_shift;
+            if (bit_shift && i + word_shift + 1 < WORDS) w |= words[i + word_shift + 1] << (64 - bit_shift);
+            r.words[i] = w;
+        }
+        return r;
+    }
+
+    // Клетки, соседние с отмеченными, с переходом через края поля, как в stepCell()
+    BitGrid neighbours() const {
+        BitGrid right = shiftUp(1).cleared(FIRST_COLUMN) | masked(LAST_COLUMN).shiftDown(W - 1);
+        BitGrid left = shiftDown(1).cleared(LAST_COLUMN) | masked(FIRST_COLUMN).shiftUp(W - 1);
+        BitGrid down = shiftUp(W) | shiftDown(CELLS - W);
+        BitGrid up = shiftDown(W) | shiftUp(CELLS - W);
+        return left | right | up | down;
+    }
+};
+
+template <int W, int H>
+class Board {
+public:
+    using Bits = BitGrid<W, H>;
+
+    Bits occupancy;
+    Bits food;
+
+    // Снимок состояния обычной игры; поле игры должно быть ровно W x H
+    void load(const GameState& game) {
+        occupancy = Bits();
+        food = Bits();
+        for (size_t i = 0; i < game.snake.tsize; ++i) {
+            Tail t = game.snake.segment(i);
+            occupancy.set(t.x, t.y);
+        }
+        for (size_t i = 0; i < game.food.size(); ++i) {
+            if (game.food.enabled(i)) food.set(game.food.x[i], game.food.y[i]);
+        }
+        synced_tick = game.tick;
+        synced = true;
+    }
+
+    // Переносит в поле изменения одного тика: только клетки из game.changed.
+    // Номер клетки в сетках GameState совпадает с номером бита, раз поле W x H.
+    void update(const GameState& game) {
+        for (uint32_t c : game.changed) {
+            int cell = static_cast<int>(c);
+            if (game.occupancy.cells[c]) occupancy.setCell(cell);
+            else occupancy.resetCell(cell);
+            if (game.food_at.cells[c] >= 0) food.setCell(cell);
+            else food.resetCell(cell);
+        }
+        synced_tick = game.tick;
+    }
+
+    // Подтягивает поле к партии: если с прошлого раза прошёл ровно один тик,
+    // хватает update(), иначе поле строится заново. После reset() или restore()
+    // партии нужен явный load(): по tick их не всегда отличить от хода.
+    void sync(const GameState& game) {
+        if (synced && game.tick == synced_tick + 1) update(game);
+        else if (!synced || game.tick != synced_tick) load(game);
+    }
+
+    bool isCrash(int x, int y) const { return occupancy.test(x, y); }
+
+    // Все клетки, до которых можно дойти из (x, y), не проходя через змейку
+    Bits reachable(int x, int y) const {
+        Bits open = ~occupancy;
+        Bits seen;
+        seen.set(x, y);
+        while (true) {
+            Bits next = seen | (seen.neighbours() & open);
+            if (next == seen) return seen;
+            seen = next;
+        }
+    }
+
+private:
+    uint64_t synced_tick = 0;
+    bool synced = false;
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include "bot.h"
+
+#include "autopilot.h"
+
+#include <climits>
+#include <cstdlib>
+
+namespace {
+
+const int DIRECTIONS[] = {LEFT, UP, RIGHT, DOWN};
+
+bool isSafe(const GameState& game, int direction) {
+    int x = game.snake.x, y = game.snake.y;
+    stepCell(x, y, direction, game.width, game.height);
+    return game.isFree(x, y);
+}
+
+// Расстояние по одной оси с учётом перехода через край поля
+int wrappedDistance(int a, int b, int size) {
+    int d = abs(a - b);
+    return d < size - d ? d : size - d;
+}
+
+}
+
+int RandomBot::decide(const GameState& game) {
+    if (isSafe(game, game.snake.direction) && rng.below(8) != 0) return 0;
+
+    int safe[4];
+    int count = 0;
+    for (int direction : DIRECTIONS) {
+        if (isSafe(game, direction)) safe[count++] = direction;
+    }
+    return count ? safe[rng.below(count)] : 0;
+}
+
+int GreedyBot::decide(const GameState& game) {
+    const FoodSet& food = game.food;
+    size_t target = food.size();
+    int best = INT_MAX;
+    for (size_t i = 0; i < food.size(); ++i) {
+        if (!food.enabled(i)) continue;
+        int d = wrappedDistance(food.x[i], game.snake.x, game.width) + wrappedDistance(food.y[i], game.snake.y, game.height);
+        if (d < best) {
+            best = d;
+            target = i;
+        }
+    }
+
+    int choice = 0;
+    best = INT_MAX;
+    for (int direction : DIRECTIONS) {
+        int x = game.snake.x, y = game.snake.y;
+        stepCell(x, y, direction, game.width, game.height);
+        if (!game.isFree(x, y)) continue;
+        int d = 0;
+        if (target < food.size()) {
+            d = wrappedDistance(food.x[target], x, game.width) + wrappedDistance(food.y[target], y, game.height);
+        }
+        if (d < best) {
+            best = d;
+            choice = direction;
+        }
+    }
+    return choice;
+}
+
+template <int W, int H>
+int FloodBot<W, H>::decide(const GameState& game) {
+    board.sync(game);
+    const FoodSet& food = game.food;
+    size_t target = food.size();
+    int best = INT_MAX;
+    for (size_t i = 0; i < food.size(); ++i) {
+        if (!food.enabled(i)) continue;
+        int d = wrappedDistance(food.x[i], game.snake.x, W) + wrappedDistance(food.y[i], game.snake.y, H);
+        if (d < best) {
+            best = d;
+            target = i;
+        }
+    }
+
+    // Сначала ходы, после которых достижимо не меньше клеток, чем длина змейки,
+    // среди них — ближе к еде; если таких нет, то ход в самую большую область
+    int choice = 0;
+    bool best_roomy = false;
+    int best_distance = INT_MAX, best_area = -1;
+    // Соседи головы часто лежат в одной области, её заливаем один раз
+    typename Board<W, H>::Bits regions[4];
+    int areas[4];
+    int filled = 0;
+    for (int direction : DIRECTIONS) {
+        int x = game.snake.x, y = game.snake.y;
+        stepCell(x, y, direction, W, H);
+        if (board.isCrash(x, y)) continue;
+        int r = 0;
+        while (r < filled && !regions[r].test(x, y)) ++r;
+        if (r == filled) {
+            regions[r] = board.reachable(x, y);
+            areas[r] = regions[r].count();
+            ++filled;
+        }
+        int area = areas[r];
+        bool roomy = static_cast<size_t>(area) >= game.snake.tsize;
+        int d = 0;
+        if (target < food.size()) {
+            d = wrappedDistance(food.x[target], x, W) + wrappedDistance(food.y[target], y, H);
+        }
+        bool better = roomy != best_roomy ? roomy
+            : roomy ? d < best_distance
+            : area > best_area;
+        if (choice == 0 || better) {
+            choice = direction;
+            best_roomy = roomy;
+            best_distance = d;
+            best_area = area;
+        }
+    }
+    return choice;
+}
+
+template class FloodBot<FLOOD_BOARD_SIDE, FLOOD_BOARD_SIDE>;
+
+std::unique_ptr<Bot> makeBot(const std::string& name, uint64_t seed, int width, int height) {
+    if (name == "random") return std::unique_ptr<Bot>(new RandomBot(seed));
+    if (name == "greedy") return std::unique_ptr<Bot>(new GreedyBot());
+    if (name == "autopilot") return std::unique_ptr<Bot>(new AutopilotBot());
+    if (name == "flood" && width == FLOOD_BOARD_SIDE && height == FLOOD_BOARD_SIDE) {
+        return std::unique_ptr<Bot>(new FloodBot<FLOOD_BOARD_SIDE, FLOOD_BOARD_SIDE>());
+    }
+    return nullptr;
+}
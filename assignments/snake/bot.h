@@ -0,0 +1,59 @@
+#ifndef SNAKE_BOT_H
+#define SNAKE_BOT_H
+
+/*
+ * Боты — автоматические игроки. Бот смотрит на GameState и возвращает
+ * направление для следующего тика, то есть подменяет собой клавиатуру.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "bitboard.h"
+#include "game.h"
+#include "random.h"
+
+class Bot {
+public:
+    virtual ~Bot() = default;
+    // Направление для следующего step() или 0, чтобы не поворачивать
+    virtual int decide(const GameState& game) = 0;
+};
+
+// Держит курс и изредка поворачивает наугад, избегая клеток со змейкой
+class RandomBot : public Bot {
+public:
+    explicit RandomBot(uint64_t seed) : rng(seed) {}
+    int decide(const GameState& game) override;
+
+private:
+    Random rng;
+};
+
+// Идёт к ближайшей еде по манхэттенскому расстоянию, обходя соседние клетки со змейкой
+class GreedyBot : public Bot {
+public:
+    int decide(const GameState& game) override;
+};
+
+// Как GreedyBot, но не заходит в область, где змейке не хватит места: для каждого
+// хода заливкой по битовому полю Board<W, H> считается, сколько клеток останется
+// достижимо. Поле ведётся по changed между тиками. Игра должна быть ровно W x H.
+template <int W, int H>
+class FloodBot : public Bot {
+public:
+    int decide(const GameState& game) override;
+
+private:
+    Board<W, H> board;
+};
+
+// Сторона поля, для которой собран FloodBot
+enum {FLOOD_BOARD_SIDE=20};
+
+// Создаёт бота по имени ("random", "greedy", "autopilot", "flood") для партий
+// на поле width x height; для неизвестного имени или неподходящего поля возвращает nullptr
+std::unique_ptr<Bot> makeBot(const std::string& name, uint64_t seed, int width, int height);
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef SNAKE_CHUNK_GRID_H
+#define SNAKE_CHUNK_GRID_H
+
+/*
+ * Разреженная сетка для очень больших полей. Поле разбито на квадратные куски
+ * CHUNK_SIDE x CHUNK_SIDE, и в памяти есть только куски, где хоть одна клетка
+ * отлична от T(): кусок заводится при первой записи и удаляется, когда в нём
+ * снова не остаётся значений. Так память растёт с числом занятых клеток,
+ * а не с размером поля.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+template <typename T>
+class ChunkGrid {
+public:
+    enum {CHUNK_BITS=6, CHUNK_SIDE=1 << CHUNK_BITS, CHUNK_CELLS=CHUNK_SIDE * CHUNK_SIDE};
+
+    struct Chunk {
+        std::array<T, CHUNK_CELLS> cells{};
+        // Сколько клеток куска отличны от T()
+        size_t used = 0;
+    };
+
+    int width, height;
+
+    ChunkGrid(int width, int height) : width(width), height(height) {}
+
+    T get(int x, int y) const {
+        const Chunk* c = chunk(x >> CHUNK_BITS, y >> CHUNK_BITS);
+        return c ? c->cells[offset(x, y)] : T();
+    }
+
+    void set(int x, int y, T value) {
+        uint64_t k = key(x >> CHUNK_BITS, y >> CHUNK_BITS);
+        Chunk* c = find(k);
+        if (!c) {
+            if (value == T()) return;
+            c = (chunks[k] = std::unique_ptr<Chunk>(new Chunk())).get();
+            last_key = k;
+            last_chunk = c;
+        }
+        T& cell = c->cells[offset(x, y)];
+        if (cell == T() && value != T()) c->used++;
+        if (cell != T() && value == T()) c->used--;
+        cell = value;
+        if (c->used == 0) {
+            chunks.erase(k);
+            last_chunk = nullptr;
+        }
+    }
+
+    // Кусок с координатами (cx, cy) в кусках или nullptr, если он пуст
+    const Chunk* chunk(int cx, int cy) const { return find(key(cx, cy)); }
+
+    size_t chunkCount() const { return chunks.size(); }
+    size_t memoryBytes() const { return chunks.size() * sizeof(Chunk); }
+
+    // Вызывает fn(dx, dy, value) для непустых клеток окна w x h с левым верхним
+    // углом (left, top); окно может переходить через край поля. Просматриваются
+    // только существующие куски, попавшие в окно.
+    template <typename Fn>
+    void forEachIn(int left, int top, int w, int h, Fn fn) const {
+        for (int dy = 0; dy < h;) {
+            int y = (top + dy) % height;
+            int rows = std::min({CHUNK_SIDE - (y & (CHUNK_SIDE - 1)), h - dy, height - y});
+            for (int dx = 0; dx < w;) {
+                int x = (left + dx) % width;
+                int cols = std::min({CHUNK_SIDE - (x & (CHUNK_SIDE - 1)), w - dx, width - x});
+                if (const Chunk* c = chunk(x >> CHUNK_BITS, y >> CHUNK_BITS)) {
+                    for (int i = 0; i < rows; ++i) {
+                        for (int j = 0; j < cols; ++j) {
+                            T value = c->cells[offset(x + j, y + i)];
+                            if (value != T()) fn(dx + j, dy + i, value);
+                        }
+                    }
+                }
+                dx += cols;
+            }
+            dy += rows;
+        }
+    }
+
+private:
+    std::unordered_map<uint64_t, std::unique_ptr<Chunk>> chunks;
+    // Змейка обычно обращается к одному и тому же куску несколько раз подряд
+    mutable uint64_t last_key = 0;
+    mutable Chunk* last_chunk = nullptr;
+
+    static uint64_t key(int cx, int cy) { return (static_cast<uint64_t>(cy) << 32) | static_cast<uint32_t>(cx); }
+    static size_t offset(int x, int y) { return (y & (CHUNK_SIDE - 1)) * CHUNK_SIDE + (x & (CHUNK_SIDE - 1)); }
+
+    Chunk* find(uint64_t k) const {
+        if (last_chunk && last_key == k) return last_chunk;
+        auto it = chunks.find(k);
+        if (it == chunks.end()) return nullptr;
+        last_key = k;
+        last_chunk = it->second.get();
+        return last_chunk;
+    }
+};
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef SNAKE_FREE_CELLS_H
+#define SNAKE_FREE_CELLS_H
+
+/*
+ * Множество свободных клеток поля с равномерной выборкой за O(1).
+ * Клетки лежат плотным массивом, а для каждой клетки хранится её позиция в нём,
+ * поэтому удаление — это обмен с последним элементом и pop_back.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class FreeCells {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    std::vector<uint32_t> cells;
+    std::vector<uint32_t> pos;
+
+    explicit FreeCells(size_t cell_count) : pos(cell_count, NONE) {
+        cells.reserve(cell_count);
+    }
+
+    // Все клетки поля свободны
+    void fill() {
+        cells.resize(pos.size());
+        for (size_t c = 0; c < pos.size(); ++c) {
+            cells[c] = static_cast<uint32_t>(c);
+            pos[c] = static_cast<uint32_t>(c);
+        }
+    }
+
+    size_t size() const { return cells.size(); }
+    bool empty() const { return cells.empty(); }
+    bool contains(uint32_t cell) const { return pos[cell] != NONE; }
+
+    void insert(uint32_t cell) {
+        if (contains(cell)) return;
+        pos[cell] = static_cast<uint32_t>(cells.size());
+        cells.push_back(cell);
+    }
+
+    void erase(uint32_t cell) {
+        uint32_t p = pos[cell];
+        if (p == NONE) return;
+        uint32_t last = cells.back();
+        cells[p] = last;
+        pos[last] = p;
+        cells.pop_back();
+        pos[cell] = NONE;
+    }
+
+    // rng — генератор с методом below(n), см. random.h
+    template <typename Rng>
+    uint32_t sample(Rng& rng) const { return cells[rng.below(cells.size())]; }
+};
+
+#endif
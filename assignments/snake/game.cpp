@@ -0,0 +1,298 @@
+#include "game.h"
+
+#include <cstring>
+
+namespace {
+
+// Скалярная часть снимка; массивы идут в буфере сразу за ней
+struct SnapshotHeader {
+    int32_t width, height;
+    uint64_t food_count;
+    uint64_t rng[4];
+    uint64_t tick;
+    int32_t x, y, direction;
+    uint8_t over;
+    uint64_t tsize, capacity;
+    uint64_t free_count;
+    uint64_t wheel_entries;
+};
+
+// Пустой массив может не иметь буфера (data() == nullptr), а memcpy
+// с нулевым указателем не определён даже для нуля байт
+template <typename T>
+unsigned char* putArray(unsigned char* out, const T* data, size_t count) {
+    if (count) memcpy(out, data, count * sizeof(T));
+    return out + count * sizeof(T);
+}
+
+template <typename T>
+const unsigned char* getArray(const unsigned char* in, T* data, size_t count) {
+    if (count) memcpy(data, in, count * sizeof(T));
+    return in + count * sizeof(T);
+}
+
+// Размер снимка с таким заголовком на поле из cells клеток
+size_t snapshotSize(const SnapshotHeader& header, size_t cells, size_t wheel_slots) {
+    return sizeof(header)
+        + 2 * header.tsize * sizeof(uint16_t)
+        + header.food_count * (2 * sizeof(uint16_t) + sizeof(uint64_t))
+        + cells * (sizeof(uint8_t) + sizeof(int32_t) + sizeof(uint32_t))
+        + header.free_count * sizeof(uint32_t)
+        + wheel_slots * sizeof(uint32_t)
+        + header.wheel_entries * sizeof(GameState::FoodTimer);
+}
+
+}
+
+void stepCell(int& x, int& y, int direction, int width, int height) {
+    switch (direction) {
+        case LEFT:
+            x = (x <= 0) ? width - 1 : x - 1;
+            break;
+        case RIGHT:
+            x = (x >= width - 1) ? 0 : x + 1;
+            break;
+        case UP:
+            y = (y <= 0) ? height - 1 : y - 1;
+            break;
+        case DOWN:
+            y = (y >= height - 1) ? 0 : y + 1;
+            break;
+    }
+}
+
+GameState::GameState(int width, int height, uint64_t seed, size_t food_count)
+    : width(width), height(height), snake(START_TAIL_SIZE, 1),
+      food(food_count),
+      occupancy(width, height), food_at(width, height, -1),
+      free_cells(static_cast<size_t>(width) * height),
+      expiry_wheel(FOOD_EXPIRE_TICKS + 1), rng(seed), tick(0), over(false) {
+    reset(seed);
+}
+
+void GameState::reset(uint64_t seed) {
+    rng = Random(seed);
+    tick = 0;
+    over = false;
+    snake.reset(START_TAIL_SIZE, 1);
+    food.clear();
+    std::fill(occupancy.cells.begin(), occupancy.cells.end(), 0);
+    std::fill(food_at.cells.begin(), food_at.cells.end(), -1);
+    free_cells.fill();
+    changed.clear();
+    for (auto& slot : expiry_wheel) {
+        slot.clear();
+    }
+
+    for (size_t i = 0; i < snake.tsize; ++i) {
+        Tail t = snake.segment(i);
+        occupy(t.x, t.y);
+    }
+    putFood();
+}
+
+StepResult GameState::step(int input) {
+    if (over) return STEP_CRASHED;
+    if (input) snake.direction = input;
+    tick++;
+    changed.clear();
+
+    // Клетка, которую освобождает последний сегмент
+    Tail vacated = snake.segment(snake.tsize - 1);
+    release(vacated.x, vacated.y);
+
+    snake.move(width, height);
+    snake.moveTail();
+
+    if (isCrash()) {
+        over = true;
+        return STEP_CRASHED;
+    }
+    occupy(snake.x, snake.y);
+
+    bool ate = haveEat();
+    if (ate) {
+        // Новый сегмент вырастает там, откуда только что ушёл хвост
+        snake.addTail(vacated);
+        occupy(vacated.x, vacated.y);
+    }
+
+    refreshFood();
+
+    return ate ? STEP_ATE : STEP_MOVED;
+}
+
+void GameState::occupy(int x, int y) {
+    uint32_t cell = cellId(x, y);
+    if (occupancy.at(x, y)++ == 0) free_cells.erase(cell);
+    changed.push_back(cell);
+}
+
+void GameState::release(int x, int y) {
+    uint32_t cell = cellId(x, y);
+    if (--occupancy.at(x, y) == 0 && food_at.at(x, y) < 0) free_cells.insert(cell);
+    changed.push_back(cell);
+}
+
+void GameState::putFoodSeed(size_t i) {
+    if (food.enabled(i)) {
+        int x = food.x[i], y = food.y[i];
+        food_at.at(x, y) = -1;
+        if (occupancy.at(x, y) == 0) free_cells.insert(cellId(x, y));
+        food.disable(i);
+        changed.push_back(cellId(x, y));
+    }
+    if (free_cells.empty()) {
+        // Поле забито: пробуем выложить еду в следующем тике
+        expiry_wheel[(tick + 1) % expiry_wheel.size()].push_back({i, tick + 1});
+        return;
+    }
+    // Еда выкладывается только на свободную клетку, поэтому на змейку она не попадёт
+    uint32_t cell = free_cells.sample(rng);
+    free_cells.erase(cell);
+    changed.push_back(cell);
+    food.x[i] = static_cast<uint16_t>(cell % width);
+    food.y[i] = static_cast<uint16_t>(cell / width);
+    food_at.at(food.x[i], food.y[i]) = static_cast<int32_t>(i);
+    food.put_tick[i] = tick;
+    uint64_t due = tick + FOOD_EXPIRE_TICKS;
+    expiry_wheel[due % expiry_wheel.size()].push_back({i, due});
+}
+
+void GameState::putFood() {
+    for (size_t i = 0; i < food.size(); ++i) {
+        putFoodSeed(i);
+    }
+}
+
+void GameState::refreshFood() {
+    // Новые таймеры попадают в другие слоты, поэтому текущий можно обходить по индексу
+    std::vector<FoodTimer>& slot = expiry_wheel[tick % expiry_wheel.size()];
+    for (size_t k = 0; k < slot.size(); ++k) {
+        const FoodTimer& timer = slot[k];
+        size_t i = timer.food;
+        if (timer.due == tick && (!food.enabled(i) || food.put_tick[i] + FOOD_EXPIRE_TICKS == tick)) {
+            putFoodSeed(timer.food);
+        }
+    }
+    slot.clear();
+}
+
+bool GameState::haveEat() {
+    int32_t i;
+    if (scan_lookups) {
+        size_t found = food.find(snake.x, snake.y);
+        i = found < food.size() ? static_cast<int32_t>(found) : -1;
+    } else {
+        i = food_at.at(snake.x, snake.y);
+    }
+    if (i < 0) return false;
+    food_at.at(snake.x, snake.y) = -1;
+    food.disable(i);
+    // Съеденная еда появляется заново в этом же тике
+    expiry_wheel[tick % expiry_wheel.size()].push_back({static_cast<size_t>(i), tick});
+    return true;
+}
+
+void GameState::save(GameSnapshot& snapshot) const {
+    SnapshotHeader header{};
+    header.width = width;
+    header.height = height;
+    header.food_count = food.size();
+    memcpy(header.rng, rng.s, sizeof(header.rng));
+    header.tick = tick;
+    header.x = snake.x;
+    header.y = snake.y;
+    header.direction = snake.direction;
+    header.over = over;
+    header.tsize = snake.tsize;
+    header.capacity = snake.capacity();
+    header.free_count = free_cells.size();
+    for (const auto& slot : expiry_wheel) header.wheel_entries += slot.size();
+
+    size_t cells = occupancy.cells.size();
+    snapshot.bytes.resize(snapshotSize(header, cells, expiry_wheel.size()));
+
+    unsigned char* out = putArray(snapshot.bytes.data(), &header, 1);
+    // Кольцо хвоста сохраняется развёрнутым: голова первой
+    size_t first = std::min(snake.tsize, snake.capacity() - snake.head);
+    out = putArray(out, snake.tail_x.data() + snake.head, first);
+    out = putArray(out, snake.tail_x.data(), snake.tsize - first);
+    out = putArray(out, snake.tail_y.data() + snake.head, first);
+    out = putArray(out, snake.tail_y.data(), snake.tsize - first);
+    out = putArray(out, food.x.data(), food.size());
+    out = putArray(out, food.y.data(), food.size());
+    out = putArray(out, food.put_tick.data(), food.size());
+    out = putArray(out, occupancy.cells.data(), cells);
+    out = putArray(out, food_at.cells.data(), cells);
+    out = putArray(out, free_cells.pos.data(), cells);
+    out = putArray(out, free_cells.cells.data(), free_cells.size());
+    for (const auto& slot : expiry_wheel) {
+        uint32_t count = static_cast<uint32_t>(slot.size());
+        out = putArray(out, &count, 1);
+    }
+    for (const auto& slot : expiry_wheel) {
+        out = putArray(out, slot.data(), slot.size());
+    }
+}
+
+bool GameState::restore(const GameSnapshot& snapshot) {
+    if (snapshot.size() < sizeof(SnapshotHeader)) return false;
+    SnapshotHeader header;
+    const unsigned char* in = getArray(snapshot.bytes.data(), &header, 1);
+    if (header.width != width || header.height != height || header.food_count != food.size()) return false;
+    // Обрезанный или чужой снимок: размер не сходится с заголовком
+    size_t cells = occupancy.cells.size();
+    if (header.tsize == 0 || header.tsize > cells || header.tsize > header.capacity ||
+        header.capacity > 2 * cells + START_TAIL_CAPACITY || header.free_count > cells ||
+        header.wheel_entries > snapshot.size() ||
+        snapshot.size() != snapshotSize(header, cells, expiry_wheel.size())) {
+        return false;
+    }
+    size_t counts_offset = snapshot.size() - header.wheel_entries * sizeof(FoodTimer)
+        - expiry_wheel.size() * sizeof(uint32_t);
+    const unsigned char* counts = snapshot.bytes.data() + counts_offset;
+    uint64_t entries = 0;
+    for (size_t k = 0; k < expiry_wheel.size(); ++k) {
+        uint32_t count;
+        counts = getArray(counts, &count, 1);
+        entries += count;
+    }
+    if (entries != header.wheel_entries) return false;
+
+    memcpy(rng.s, header.rng, sizeof(header.rng));
+    tick = header.tick;
+    over = header.over != 0;
+    changed.clear();
+
+    snake.x = header.x;
+    snake.y = header.y;
+    snake.direction = header.direction;
+    snake.tsize = header.tsize;
+    snake.head = 0;
+    if (snake.capacity() < header.capacity) {
+        snake.tail_x.resize(header.capacity);
+        snake.tail_y.resize(header.capacity);
+    }
+    in = getArray(in, snake.tail_x.data(), snake.tsize);
+    in = getArray(in, snake.tail_y.data(), snake.tsize);
+
+    in = getArray(in, food.x.data(), food.size());
+    in = getArray(in, food.y.data(), food.size());
+    in = getArray(in, food.put_tick.data(), food.size());
+    in = getArray(in, occupancy.cells.data(), cells);
+    in = getArray(in, food_at.cells.data(), cells);
+    in = getArray(in, free_cells.pos.data(), cells);
+    free_cells.cells.resize(header.free_count);
+    in = getArray(in, free_cells.cells.data(), free_cells.size());
+
+    counts = in;
+    in += expiry_wheel.size() * sizeof(uint32_t);
+    for (auto& slot : expiry_wheel) {
+        uint32_t count;
+        counts = getArray(counts, &count, 1);
+        slot.resize(count);
+        in = getArray(in, slot.data(), count);
+    }
+    return true;
+}
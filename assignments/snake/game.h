@@ -0,0 +1,230 @@
+#ifndef SNAKE_GAME_H
+#define SNAKE_GAME_H
+
+/*
+ * Игровая логика змейки без привязки к терминалу.
+ * GameState — чистый автомат состояний: step(input) продвигает игру на один тик
+ * на поле явно заданного размера, а отрисовкой занимается Renderer (renderer.h).
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "free_cells.h"
+#include "grid.h"
+#include "random.h"
+#include "simd.h"
+
+enum {LEFT=1, UP, RIGHT, DOWN, STOP_GAME='q'};
+enum {START_TAIL_SIZE=3, START_TAIL_CAPACITY=8, MAX_FOOD_SIZE=20, FOOD_EXPIRE_TICKS=100, SPEED=20000, SEED_NUMBER=3};
+// Координаты хвоста в GameState хранятся в 16 битах
+enum {MAX_BOARD_SIDE=UINT16_MAX};
+
+// Результат одного тика
+enum StepResult {STEP_MOVED, STEP_ATE, STEP_CRASHED};
+
+// Сдвигает клетку (x, y) на один шаг в направлении direction с переходом через край поля
+void stepCell(int& x, int& y, int direction, int width, int height);
+
+template <typename Coord>
+struct BasicTail {
+    Coord x, y;
+};
+
+// Еда хранится структурой массивов: координаты всей еды лежат подряд, чтобы
+// их можно было просматривать SIMD-ядрами из simd.h. У выключенной еды x == NO_FOOD.
+class FoodSet {
+public:
+    static constexpr uint16_t NO_FOOD = UINT16_MAX;
+
+    std::vector<uint16_t> x, y;
+    std::vector<uint64_t> put_tick;
+    char point;
+
+    explicit FoodSet(size_t count) : x(count, NO_FOOD), y(count, NO_FOOD), put_tick(count, 0), point('$') {}
+
+    void clear() {
+        std::fill(x.begin(), x.end(), NO_FOOD);
+        std::fill(put_tick.begin(), put_tick.end(), 0);
+    }
+
+    size_t size() const { return x.size(); }
+    bool enabled(size_t i) const { return x[i] != NO_FOOD; }
+    void disable(size_t i) { x[i] = NO_FOOD; }
+
+    // Индекс еды в клетке (cx, cy) или size(), если её там нет. Перебор без сетки food_at
+    size_t find(int cx, int cy) const {
+        return findCell(x.data(), y.data(), size(), static_cast<uint16_t>(cx), static_cast<uint16_t>(cy));
+    }
+};
+
+// Хвост хранится в кольцевом буфере: сегмент в позиции head — голова, дальше по
+// кольцу идут остальные. Сдвиг змейки — одна запись, независимо от длины.
+// Буфер растёт вдвое по мере надобности, так что память пропорциональна длине,
+// а тип Coord позволяет хранить координаты компактно, если поле это позволяет.
+// Координаты x и y лежат в отдельных массивах, чтобы hitsTail() шёл SIMD-ядром.
+template <typename Coord>
+class BasicSnake {
+public:
+    using Segment = BasicTail<Coord>;
+
+    int x, y, direction;
+    size_t tsize;
+    size_t head;
+    std::vector<Coord> tail_x, tail_y;
+
+    BasicSnake(int start_x, int start_y) : tail_x(START_TAIL_CAPACITY), tail_y(START_TAIL_CAPACITY) {
+        reset(start_x, start_y);
+    }
+
+    // Начальная змейка; уже выделенная под хвост память сохраняется
+    void reset(int start_x, int start_y) {
+        x = start_x;
+        y = start_y;
+        direction = RIGHT;
+        tsize = START_TAIL_SIZE+1;
+        head = 0;
+        // Хвост изначально вытянут влево от головы
+        for (size_t i = 0; i < tsize; ++i) {
+            tail_x[i] = static_cast<Coord>(x - static_cast<int>(i));
+            tail_y[i] = static_cast<Coord>(y);
+        }
+    }
+
+    size_t capacity() const { return tail_x.size(); }
+
+    // i-й сегмент, считая от головы (0 — голова)
+    Segment segment(size_t i) const {
+        size_t pos = head + i;
+        if (pos >= capacity()) pos -= capacity();
+        return {tail_x[pos], tail_y[pos]};
+    }
+
+    void move(int width, int height) {
+        stepCell(x, y, direction, width, height);
+    }
+
+    void moveTail() {
+        // Новая голова занимает слот перед старой, последний сегмент выпадает сам
+        head = (head == 0) ? capacity() - 1 : head - 1;
+        tail_x[head] = static_cast<Coord>(x);
+        tail_y[head] = static_cast<Coord>(y);
+    }
+
+    // Добавляет сегмент t в конец хвоста
+    void addTail(const Segment& t) {
+        if (tsize == capacity()) {
+            // Буфер заполнен целиком: разворачиваем кольцо в начало вдвое большего
+            grow(tail_x);
+            grow(tail_y);
+            head = 0;
+        }
+        size_t pos = head + tsize;
+        if (pos >= capacity()) pos -= capacity();
+        tail_x[pos] = t.x;
+        tail_y[pos] = t.y;
+        tsize++;
+    }
+
+    // Есть ли клетка (cx, cy) среди сегментов кроме головы. Перебор без сетки
+    // занятости: кольцо просматривается двумя непрерывными кусками.
+    bool hitsTail(int cx, int cy) const {
+        size_t start = head + 1;
+        if (start >= capacity()) start -= capacity();
+        size_t count = tsize - 1;
+        size_t first = std::min(count, capacity() - start);
+        Coord px = static_cast<Coord>(cx), py = static_cast<Coord>(cy);
+        if (findCell(tail_x.data() + start, tail_y.data() + start, first, px, py) < first) return true;
+        size_t second = count - first;
+        return findCell(tail_x.data(), tail_y.data(), second, px, py) < second;
+    }
+
+private:
+    void grow(std::vector<Coord>& ring) {
+        std::vector<Coord> bigger(ring.size() * 2);
+        std::rotate_copy(ring.begin(), ring.begin() + head, ring.end(), bigger.begin());
+        ring.swap(bigger);
+    }
+};
+
+using Tail = BasicTail<uint16_t>;
+using Snake = BasicSnake<uint16_t>;
+
+// Снимок партии для перебора вариантов (см. GameState::save). Всё состояние
+// упаковано в один непрерывный буфер байтов, поэтому копия снимка — один memcpy,
+// а повторное сохранение в тот же снимок обходится без выделения памяти.
+class GameSnapshot {
+public:
+    std::vector<unsigned char> bytes;
+
+    size_t size() const { return bytes.size(); }
+};
+
+class GameState {
+public:
+    int width, height;
+    Snake snake;
+    FoodSet food;
+    // Сколько сегментов змейки занимают каждую клетку поля
+    Grid<uint8_t> occupancy;
+    // Индекс еды в food для каждой клетки, -1 — клетка пуста
+    Grid<int32_t> food_at;
+    // Клетки без змейки и без еды — отсюда выбирается место для новой еды
+    FreeCells free_cells;
+    // Колесо таймеров: в слоте (тик % размер) лежат индексы еды, которая в этот тик
+    // протухает. Записи не удаляются при перекладывании еды, а отбрасываются при
+    // обработке, если put_tick уже не совпадает.
+    struct FoodTimer {
+        size_t food;
+        uint64_t due;
+    };
+    std::vector<std::vector<FoodTimer>> expiry_wheel;
+    Random rng;
+    uint64_t tick;
+    bool over;
+    // Клетки, в которых за последний step() менялись змейка или еда (могут повторяться)
+    std::vector<uint32_t> changed;
+    // Столкновение и еда под головой ищутся просмотром хвоста и еды ядрами
+    // из simd.h, а не по сеткам occupancy и food_at. Сетки всё равно ведутся:
+    // по ним выбираются свободные клетки. Партия от этого не меняется.
+    bool scan_lookups = false;
+
+    // Одинаковые размер поля, зерно и ввод всегда дают одну и ту же партию.
+    // Стороны поля не больше MAX_BOARD_SIDE.
+    GameState(int width, int height, uint64_t seed = SEED_NUMBER, size_t food_count = MAX_FOOD_SIZE);
+
+    // Новая партия с тем же полем и тем же количеством еды; память не перевыделяется
+    void reset(uint64_t seed);
+
+    // Сохраняет партию в snapshot, переиспользуя его буфер
+    void save(GameSnapshot& snapshot) const;
+    GameSnapshot fork() const {
+        GameSnapshot snapshot;
+        save(snapshot);
+        return snapshot;
+    }
+    // Возвращает партию к снимку, сделанному на поле того же размера и с тем же
+    // количеством еды; иначе состояние не меняется и возвращается false.
+    // После восстановления changed пуст: наблюдателям нужно перечитать всё поле.
+    bool restore(const GameSnapshot& snapshot);
+
+    // input — новое направление (LEFT/UP/RIGHT/DOWN) или 0, если клавиша не нажата
+    StepResult step(int input);
+
+    bool isFree(int x, int y) const { return occupancy.at(x, y) == 0; }
+    bool isCrash() const { return scan_lookups ? snake.hitsTail(snake.x, snake.y) : !isFree(snake.x, snake.y); }
+
+    void putFoodSeed(size_t i);
+    void putFood();
+    void refreshFood();
+    bool haveEat();
+
+private:
+    uint32_t cellId(int x, int y) const { return static_cast<uint32_t>(occupancy.index(x, y)); }
+    void occupy(int x, int y);
+    void release(int x, int y);
+};
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef SNAKE_GRID_H
+#define SNAKE_GRID_H
+
+/*
+ * Плоская сетка значений размером с игровое поле.
+ * Используется как индекс «что лежит в клетке», чтобы проверки
+ * столкновений и свободных клеток делались одним обращением к памяти.
+ */
+
+#include <cstddef>
+#include <vector>
+
+template <typename T>
+class Grid {
+public:
+    int width, height;
+    std::vector<T> cells;
+
+    Grid(int width, int height, T value = T())
+        : width(width), height(height), cells(static_cast<size_t>(width) * height, value) {}
+
+    size_t index(int x, int y) const { return static_cast<size_t>(y) * width + x; }
+
+    T& at(int x, int y) { return cells[index(x, y)]; }
+    const T& at(int x, int y) const { return cells[index(x, y)]; }
+};
+
+#endif
@@ -0,0 +1,56 @@
+#include "input.h"
+
+#include <ncurses.h>
+#include <poll.h>
+#include <unistd.h>
+
+InputThread::InputThread() : running(true), dropped_keys(0), thread(&InputThread::run, this) {}
+
+InputThread::~InputThread() {
+    stop();
+}
+
+void InputThread::stop() {
+    running = false;
+    if (thread.joinable()) thread.join();
+}
+
+void InputThread::run() {
+    // Стрелки приходят как ESC [ A или ESC O A (в режиме keypad)
+    enum {PLAIN, ESCAPE, SEQUENCE};
+    int state = PLAIN;
+    unsigned char bytes[64];
+
+    while (running) {
+        pollfd fd = {STDIN_FILENO, POLLIN, 0};
+        if (poll(&fd, 1, POLL_MS) <= 0) continue;
+        ssize_t n = read(STDIN_FILENO, bytes, sizeof(bytes));
+        if (n <= 0) continue;
+        auto now = std::chrono::steady_clock::now();
+
+        for (ssize_t i = 0; i < n; ++i) {
+            int key = 0;
+            unsigned char ch = bytes[i];
+            if (state == ESCAPE) {
+                state = (ch == '[' || ch == 'O') ? SEQUENCE : PLAIN;
+                continue;
+            }
+            if (state == SEQUENCE) {
+                state = PLAIN;
+                switch (ch) {
+                    case 'A': key = KEY_UP; break;
+                    case 'B': key = KEY_DOWN; break;
+                    case 'C': key = KEY_RIGHT; break;
+                    case 'D': key = KEY_LEFT; break;
+                    default: continue;
+                }
+            } else if (ch == 27) {
+                state = ESCAPE;
+                continue;
+            } else {
+                key = ch;
+            }
+            if (!queue.push({key, now})) dropped_keys.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
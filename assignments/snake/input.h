@@ -0,0 +1,48 @@
+#ifndef SNAKE_INPUT_H
+#define SNAKE_INPUT_H
+
+/*
+ * Отдельный поток чтения клавиатуры. Он читает байты терминала напрямую из
+ * stdin (ncurses не потокобезопасен, поэтому getch() здесь не используется),
+ * разбирает escape-последовательности стрелок и кладёт нажатия с отметкой
+ * времени в очередь SpscRing. Игровой цикл забирает их между тиками.
+ * Терминал к этому моменту уже должен быть в raw-режиме (см. Renderer).
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+
+#include "spsc_ring.h"
+
+struct KeyEvent {
+    // Код клавиши в терминах ncurses: KEY_UP и т.д. для стрелок, иначе символ
+    int key;
+    std::chrono::steady_clock::time_point time;
+};
+
+class InputThread {
+public:
+    enum {QUEUE_SIZE=64, POLL_MS=20};
+
+    InputThread();
+    ~InputThread();
+
+    // Останавливает поток; после этого клавиши снова можно читать через Renderer
+    void stop();
+
+    bool pop(KeyEvent& event) { return queue.pop(event); }
+    // Нажатия, не поместившиеся в очередь
+    size_t dropped() const { return dropped_keys.load(std::memory_order_relaxed); }
+
+private:
+    SpscRing<KeyEvent, QUEUE_SIZE> queue;
+    std::atomic<bool> running;
+    std::atomic<size_t> dropped_keys;
+    std::thread thread;
+
+    void run();
+};
+
+#endif
@@ -1,210 +1,232 @@
 /*
  * Для компиляции необходимо добавить ключ -lncurses
- * g++ -o snake main.cpp -lncurses
+ * g++ -o snake main.cpp game.cpp world.cpp arena.cpp simd.cpp renderer.cpp render_thread.cpp input.cpp replay.cpp stats.cpp -lncurses -pthread
+ *
+ * ./snake [--rate тиков_в_секунду] [--seed зерно] [--food N] [--record файл] [--stats]
+ *         [--world ШИРИНАxВЫСОТА] [--arena N]
+ *
+ * С --world игра идёт в большом мире (до 100000x100000), а экран следует за головой.
+ * С --arena на поле кроме змейки игрока ещё N змеек-ботов.
  */
 
-#include <iostream>
-#include <vector>
-#include <ctime>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
 #include <cstdlib>
-#include <ncurses.h>
-
-enum {LEFT=1, UP, RIGHT, DOWN, STOP_GAME='q'};
-enum {MAX_TAIL_SIZE=1000, START_TAIL_SIZE=3, MAX_FOOD_SIZE=20, FOOD_EXPIRE_SECONDS=10, SPEED=20000, SEED_NUMBER=3};
-
-struct Tail {
-    int x, y;
-};
-
-struct Food {
-    int x, y;
-    time_t put_time;
-    char point;
-    bool enable;
-};
-
-class Snake {
-public:
-    int x, y, direction;
-    size_t tsize;
-    std::vector<Tail> tail;
-
-    Snake() : x(0), y(2), direction(RIGHT), tsize(START_TAIL_SIZE+1) {
-        tail.resize(MAX_TAIL_SIZE);
-    }
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
 
-    void move() {
-        int max_x = 0, max_y = 0;
-        char ch = '@';
-        getmaxyx(stdscr, max_y, max_x);
-        mvprintw(y, x, " ");
+#include "arena.h"
+#include "game.h"
+#include "input.h"
+#include "render_thread.h"
+#include "renderer.h"
+#include "replay.h"
+#include "stats.h"
+#include "world.h"
 
-        switch (direction) {
-            case LEFT:
-                if (x <= 0) x = max_x;
-                mvprintw(y, --x, "%c", ch);
-                break;
-            case RIGHT:
-                if (x >= max_x) x = 0;
-                mvprintw(y, ++x, "%c", ch);
-                break;
-            case UP:
-                if (y <= 0) y = max_y;
-                mvprintw(--y, x, "%c", ch);
-                break;
-            case DOWN:
-                if (y >= max_y) y = 0;
-                mvprintw(++y, x, "%c", ch);
-                break;
-        }
-        refresh();
-    }
+enum {DEFAULT_TICK_RATE=10, MAX_CATCH_UP_TICKS=5};
 
-    void moveTail() {
-        char ch = '*';
-        mvprintw(tail[tsize - 1].y, tail[tsize - 1].x, " ");
-        for (size_t i = tsize - 1; i > 0; i--) {
-            tail[i] = tail[i - 1];
-            if (tail[i].y || tail[i].x) {
-                mvprintw(tail[i].y, tail[i].x, "%c", ch);
-            }
-        }
-        tail[0].x = x;
-        tail[0].y = y;
-    }
+using Clock = std::chrono::steady_clock;
 
-    void addTail() {
-        if (tsize < MAX_TAIL_SIZE) {
-            tsize++;
-        } else {
-            mvprintw(0, 0, "Can't add tail");
-        }
-    }
+static double microseconds(Clock::duration d) {
+    return std::chrono::duration<double, std::micro>(d).count();
+}
 
-    bool isCrash() {
-        for (size_t i = 1; i < tsize; ++i) {
-            if (x == tail[i].x && y == tail[i].y) return true;
-        }
-        return false;
-    }
-};
-
-void changeDirection(int& new_direction, int key) {
-    switch (key) {
-        case KEY_DOWN: new_direction = DOWN; break;
-        case KEY_UP: new_direction = UP; break;
-        case KEY_LEFT: new_direction = LEFT; break;
-        case KEY_RIGHT: new_direction = RIGHT; break;
-    }
+static void record(ReplayWriter& recorder, const GameState& game, int direction) {
+    recorder.record(game, direction);
 }
 
-void initFood(std::vector<Food>& food) {
-    int max_y = 0, max_x = 0;
-    getmaxyx(stdscr, max_y, max_x);
-    for (auto& f : food) {
-        f = {0, 0, 0, '$', false};
-    }
+// Партии в большом мире и на арене в повторы не пишутся
+static void record(ReplayWriter&, const LargeWorld&, int) {}
+static void record(ReplayWriter&, const Arena&, int) {}
+
+template <typename Game>
+static StepResult advance(Game& game, int direction) {
+    return game.step(direction);
 }
 
-void putFoodSeed(Food& fp) {
-    int max_x = 0, max_y = 0;
-    getmaxyx(stdscr, max_y, max_x);
-    mvprintw(fp.y, fp.x, " ");
-    fp.x = rand() % (max_x - 1);
-    fp.y = rand() % (max_y - 2) + 1;
-    fp.put_time = time(nullptr);
-    fp.enable = true;
-    mvprintw(fp.y, fp.x, "%c", fp.point);
+// На арене игрок — змейка 0; её гибель заканчивает партию
+static StepResult advance(Arena& arena, int direction) {
+    arena.step(&direction);
+    return arena.alive[0] ? STEP_MOVED : STEP_CRASHED;
 }
 
-void putFood(std::vector<Food>& food) {
-    for (auto& f : food) {
-        putFoodSeed(f);
-    }
+template <typename Game>
+static size_t level(const Game& game) {
+    return game.snake.tsize;
 }
 
-void refreshFood(std::vector<Food>& food) {
-    for (auto& f : food) {
-        if (f.put_time && (!f.enable || (time(nullptr) - f.put_time) > FOOD_EXPIRE_SECONDS)) {
-            putFoodSeed(f);
-        }
-    }
+static size_t level(const Arena& arena) {
+    return arena.length[0];
 }
 
-bool haveEat(Snake& snake, std::vector<Food>& food) {
-    for (auto& f : food) {
-        if (f.enable && snake.x == f.x && snake.y == f.y) {
-            f.enable = false;
-            return true;
+// Game — GameState, LargeWorld или Arena
+template <typename Game>
+static void play(Renderer& renderer, Game& game, int tick_rate, FrameStats& stats, ReplayWriter& recorder) {
+    // Тики идут с фиксированным шагом; клавиши читает отдельный поток, а цикл
+    // между тиками просто спит. За тик применяется не больше одного поворота,
+    // остальные нажатия ждут в очереди своих тиков. Готовые кадры уходят
+    // в поток отрисовки, так что медленный терминал не задерживает тики.
+    const Clock::duration tick_period = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(1.0 / tick_rate));
+    // Применённые нажатия, которых поток отрисовки, возможно, ещё не показал
+    std::vector<Frame::Key> unseen_keys;
+    InputThread input;
+    RenderThread render(renderer);
+    bool running = true;
+
+    renderer.compose(game, render.frame().cells);
+    render.publish();
+    Clock::time_point next_tick = Clock::now() + tick_period;
+
+    while (running) {
+        Clock::time_point now = Clock::now();
+        if (now < next_tick) {
+            std::this_thread::sleep_until(next_tick);
+            continue;
         }
-    }
-    return false;
-}
 
-void repairSeed(std::vector<Food>& food, Snake& snake) {
-    for (size_t i = 0; i < snake.tsize; i++) {
-        for (auto& f : food) {
-            if (f.x == snake.tail[i].x && f.y == snake.tail[i].y && f.enable) {
-                putFoodSeed(f);
+        // Если отстали, догоняем пропущенные тики, но не больше MAX_CATCH_UP_TICKS
+        int ticks = 0;
+        while (next_tick <= now && ticks < MAX_CATCH_UP_TICKS) {
+            int direction = 0;
+            KeyEvent event;
+            while (input.pop(event)) {
+                if (event.key == STOP_GAME) {
+                    running = false;
+                    break;
+                }
+                if ((direction = keyToDirection(event.key))) {
+                    unseen_keys.push_back({event.time, game.tick + 1});
+                    break;
+                }
+            }
+            if (!running) break;
+
+            Clock::time_point start = Clock::now();
+            record(recorder, game, direction);
+            StepResult result = advance(game, direction);
+            stats.update_us.push_back(microseconds(Clock::now() - start));
+            next_tick += tick_period;
+            ++ticks;
+            if (result == STEP_CRASHED) {
+                running = false;
+                break;
             }
         }
+        stats.catch_up_ticks += ticks ? ticks - 1 : 0;
+        if (next_tick <= now) next_tick = now + tick_period;
+        if (!running) break;
+
+        Frame& frame = render.frame();
+        renderer.compose(game, frame.cells);
+        frame.tick = game.tick;
+        uint64_t shown = render.shownTick();
+        unseen_keys.erase(std::remove_if(unseen_keys.begin(), unseen_keys.end(),
+                                         [shown](const Frame::Key& key) { return key.tick <= shown; }),
+                          unseen_keys.end());
+        frame.keys = unseen_keys;
+        render.publish();
     }
-}
-
-void printLevel(Snake& snake) {
-    int max_x = 0, max_y = 0;
-    getmaxyx(stdscr, max_y, max_x);
-    mvprintw(0, max_x - 10, "LEVEL: %zu", snake.tsize);
-}
 
-void printExit(Snake& snake) {
-    int max_x = 0, max_y = 0;
-    getmaxyx(stdscr, max_y, max_x);
-    mvprintw(max_y / 2, max_x / 2 - 5, "Your LEVEL is %zu", snake.tsize);
+    input.stop();
+    render.stop();
+    stats.dropped_keys = input.dropped();
+    stats.render_us = render.render_us;
+    stats.input_latency_us = render.input_latency_us;
+    stats.skipped_frames = render.published - render.presented;
+    renderer.drawExit(level(game));
+    renderer.readKey(SPEED);
 }
 
-int main() {
-    srand(time(nullptr));
-
-    Snake snake;
-    std::vector<Food> food(MAX_FOOD_SIZE);
-    initFood(food);
-
-    initscr();
-    keypad(stdscr, TRUE);
-    raw();
-    noecho();
-    curs_set(FALSE);
-    
-    mvprintw(0, 0, "  Use arrows for control. Press 'q' for EXIT");
-    putFood(food);
-    timeout(0);
-
-    int key_pressed = 0;
-    while (key_pressed != STOP_GAME) {
-        key_pressed = getch();
-        changeDirection(snake.direction, key_pressed);
-        
-        if (snake.isCrash()) break;
-
-        snake.move();
-        snake.moveTail();
-
-        if (haveEat(snake, food)) {
-            snake.addTail();
-            printLevel(snake);
+int main(int argc, char* argv[]) {
+    int tick_rate = DEFAULT_TICK_RATE;
+    uint64_t seed = time(nullptr);
+    size_t food_count = MAX_FOOD_SIZE;
+    int world_width = 0, world_height = 0;
+    size_t arena_bots = 0;
+    bool print_stats = false;
+    std::string record_path;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) {
+            tick_rate = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--food") == 0 && i + 1 < argc) {
+            food_count = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--world") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%dx%d", &world_width, &world_height) != 2) world_width = -1;
+        } else if (strcmp(argv[i], "--arena") == 0 && i + 1 < argc) {
+            arena_bots = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            print_stats = true;
         }
+    }
+    if (tick_rate <= 0) tick_rate = DEFAULT_TICK_RATE;
+    if (world_width && (world_width < START_TAIL_SIZE + 2 || world_height < 2 ||
+                        world_width > MAX_WORLD_SIDE || world_height > MAX_WORLD_SIDE)) {
+        fprintf(stderr, "--world expects WIDTHxHEIGHT, each side from 5 to %d\n", MAX_WORLD_SIDE);
+        return 1;
+    }
+    if ((world_width || arena_bots) && !record_path.empty()) {
+        fprintf(stderr, "--record is not supported with --world or --arena\n");
+        return 1;
+    }
+    if (world_width && arena_bots) {
+        fprintf(stderr, "--world and --arena cannot be combined\n");
+        return 1;
+    }
 
-        refreshFood(food);
-        repairSeed(food, snake);
-
-        timeout(100);
+    FrameStats stats;
+    ReplayWriter recorder;
+    bool record_failed = false;
+    size_t world_chunks = 0, world_bytes = 0;
+    // Поле по размеру терминала; проверяется так же, как поле из аргументов
+    int width = 0, height = 0;
+    bool terminal_fits = true;
+
+    {
+        Renderer renderer;
+        if (!world_width) {
+            renderer.boardSize(width, height);
+            terminal_fits = width > START_TAIL_SIZE && height > 1 &&
+                            width <= MAX_BOARD_SIDE && height <= MAX_BOARD_SIDE;
+        }
+        if (world_width) {
+            LargeWorld world(world_width, world_height, seed, food_count);
+            play(renderer, world, tick_rate, stats, recorder);
+            world_chunks = world.occupancy.chunkCount();
+            world_bytes = world.memoryBytes();
+        } else if (!terminal_fits) {
+            // Сообщение печатается после того, как renderer вернёт терминал
+        } else if (arena_bots) {
+            Arena arena(width, height, arena_bots + 1, 1, seed, food_count);
+            play(renderer, arena, tick_rate, stats, recorder);
+        } else {
+            GameState game(width, height, seed, food_count);
+            if (!record_path.empty()) record_failed = !recorder.open(record_path, game, seed);
+            play(renderer, game, tick_rate, stats, recorder);
+            if (recorder.isOpen()) record_failed = !recorder.close(game);
+        }
     }
 
-    printExit(snake);
-    timeout(SPEED);
-    getch();
-    endwin();
+    if (!terminal_fits) {
+        fprintf(stderr, "Terminal too small for the board: %dx%d, need at least %dx2\n",
+                width, height, START_TAIL_SIZE + 1);
+        return 1;
+    }
+    if (record_failed) fprintf(stderr, "Cannot write replay %s\n", record_path.c_str());
+    if (print_stats) {
+        stats.report(stdout);
+        if (world_width) printf("world chunks: %zu, memory: %zu KB\n", world_chunks, world_bytes / 1024);
+    }
 
     return 0;
 }
@@ -0,0 +1,48 @@
+#ifndef SNAKE_RANDOM_H
+#define SNAKE_RANDOM_H
+
+/*
+ * Быстрый генератор xoshiro256** с явным зерном.
+ * У каждой игры свой экземпляр, поэтому партии воспроизводимы
+ * и могут идти в разных потоках без общего скрытого состояния.
+ */
+
+#include <cstdint>
+
+class Random {
+public:
+    uint64_t s[4];
+
+    explicit Random(uint64_t seed) {
+        // Состояние раскладывается из зерна через splitmix64, как советуют авторы xoshiro
+        for (auto& word : s) {
+            seed += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t next() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Равномерно в [0, n) без деления (умножение с выборкой старших бит)
+    uint64_t below(uint64_t n) {
+        return static_cast<uint64_t>((static_cast<unsigned __int128>(next()) * n) >> 64);
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+#endif
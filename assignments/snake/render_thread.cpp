@@ -0,0 +1,59 @@
+#include "render_thread.h"
+
+namespace {
+
+double microseconds(std::chrono::steady_clock::duration d) {
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+}
+
+RenderThread::RenderThread(Renderer& renderer)
+    : renderer(renderer), frames(Frame(renderer.frameBuffer())), shown_tick(0), running(true),
+      thread(&RenderThread::run, this) {}
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+void RenderThread::publish() {
+    frames.publish();
+    published++;
+}
+
+void RenderThread::stop() {
+    running = false;
+    if (thread.joinable()) thread.join();
+}
+
+void RenderThread::run() {
+    uint64_t last_key_tick = 0;
+    while (running) {
+        if (!presentLatest(last_key_tick)) {
+            std::this_thread::sleep_for(std::chrono::microseconds(POLL_US));
+        }
+    }
+    // Последний опубликованный кадр показываем даже после остановки
+    presentLatest(last_key_tick);
+}
+
+bool RenderThread::presentLatest(uint64_t& last_key_tick) {
+    using Clock = std::chrono::steady_clock;
+    if (!frames.update()) return false;
+    const Frame& frame = frames.front();
+    shown_tick.store(frame.tick, std::memory_order_release);
+
+    Clock::time_point start = Clock::now();
+    renderer.present(frame.cells);
+    Clock::time_point drawn = Clock::now();
+    render_us.push_back(microseconds(drawn - start));
+    presented++;
+
+    // Кадр может повторять нажатия, уже показанные предыдущим кадром
+    for (const Frame::Key& key : frame.keys) {
+        if (key.tick <= last_key_tick) continue;
+        input_latency_us.push_back(microseconds(drawn - key.time));
+        last_key_tick = key.tick;
+    }
+    return true;
+}
@@ -0,0 +1,70 @@
+#ifndef SNAKE_RENDER_THREAD_H
+#define SNAKE_RENDER_THREAD_H
+
+/*
+ * Отрисовка в отдельном потоке. Игровой цикл собирает кадр (см.
+ * Renderer::compose) в слот тройного буфера и публикует его, не дожидаясь
+ * терминала; поток отрисовки выводит самый свежий кадр. Если терминал
+ * медленный, промежуточные кадры пропускаются, а частота тиков не меняется.
+ *
+ * Пока поток работает, вызывать ncurses из других потоков нельзя.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "renderer.h"
+#include "triple_buffer.h"
+
+struct Frame {
+    // Нажатие, которое игра применила в тике tick
+    struct Key {
+        std::chrono::steady_clock::time_point time;
+        uint64_t tick;
+    };
+
+    Grid<char> cells;
+    uint64_t tick = 0;
+    // Нажатия, которых поток отрисовки ещё мог не показать
+    std::vector<Key> keys;
+
+    explicit Frame(const Grid<char>& cells) : cells(cells) {}
+};
+
+class RenderThread {
+public:
+    enum {POLL_US=1000};
+
+    // Замеры заполняются потоком отрисовки и доступны после stop()
+    std::vector<double> render_us;
+    std::vector<double> input_latency_us;
+    size_t published = 0;
+    size_t presented = 0;
+
+    explicit RenderThread(Renderer& renderer);
+    ~RenderThread();
+
+    // Кадр, который игровой цикл заполняет перед publish()
+    Frame& frame() { return frames.back(); }
+    void publish();
+    // Тик последнего кадра, взятого потоком отрисовки
+    uint64_t shownTick() const { return shown_tick.load(std::memory_order_acquire); }
+
+    void stop();
+
+private:
+    Renderer& renderer;
+    TripleBuffer<Frame> frames;
+    std::atomic<uint64_t> shown_tick;
+    std::atomic<bool> running;
+    std::thread thread;
+
+    void run();
+    bool presentLatest(uint64_t& last_key_tick);
+};
+
+#endif
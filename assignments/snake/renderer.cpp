@@ -0,0 +1,152 @@
+#include "renderer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <ncurses.h>
+
+namespace {
+
+Grid<char> screenBuffer() {
+    initscr();
+    int max_x = 0, max_y = 0;
+    getmaxyx(stdscr, max_y, max_x);
+    return Grid<char>(max_x, max_y, ' ');
+}
+
+}
+
+Renderer::Renderer() : back(screenBuffer()), front(back) {
+    keypad(stdscr, TRUE);
+    raw();
+    noecho();
+    curs_set(FALSE);
+    erase();
+}
+
+Renderer::~Renderer() {
+    endwin();
+}
+
+void Renderer::boardSize(int& width, int& height) const {
+    width = back.width;
+    height = back.height - 1;
+}
+
+int Renderer::readKey(int timeout_ms) {
+    timeout(timeout_ms);
+    return getch();
+}
+
+void Renderer::draw(const GameState& game) {
+    compose(game, back);
+    present(back);
+}
+
+void Renderer::drawExit(size_t level) {
+    char text[64];
+    snprintf(text, sizeof(text), "Your LEVEL is %zu", level);
+    back.cells = front.cells;
+    print(back, back.width / 2 - 5, back.height / 2, text);
+    present(back);
+}
+
+void Renderer::compose(const GameState& game, Grid<char>& frame) const {
+    std::fill(frame.cells.begin(), frame.cells.end(), ' ');
+
+    char level[32];
+    snprintf(level, sizeof(level), "LEVEL: %zu", game.snake.tsize);
+    print(frame, 0, 0, "  Use arrows for control. Press 'q' for EXIT");
+    print(frame, game.width - 10, 0, level);
+
+    for (size_t i = 0; i < game.food.size(); ++i) {
+        if (game.food.enabled(i)) {
+            frame.at(game.food.x[i], game.food.y[i] + 1) = game.food.point;
+        }
+    }
+    for (size_t i = 1; i < game.snake.tsize; ++i) {
+        Tail t = game.snake.segment(i);
+        frame.at(t.x, t.y + 1) = '*';
+    }
+    frame.at(game.snake.x, game.snake.y + 1) = '@';
+}
+
+void Renderer::compose(const LargeWorld& world, Grid<char>& frame) const {
+    std::fill(frame.cells.begin(), frame.cells.end(), ' ');
+
+    char text[32];
+    print(frame, 0, 0, "  Use arrows for control. Press 'q' for EXIT");
+    snprintf(text, sizeof(text), "%d,%d", world.snake.x, world.snake.y);
+    print(frame, frame.width - 24, 0, text);
+    snprintf(text, sizeof(text), "LEVEL: %zu", world.snake.tsize);
+    print(frame, frame.width - 10, 0, text);
+
+    int view_w = std::min(frame.width, world.width);
+    int view_h = std::min(frame.height - 1, world.height);
+    int left = (world.snake.x - view_w / 2 + world.width) % world.width;
+    int top = (world.snake.y - view_h / 2 + world.height) % world.height;
+    // Еда просматривается массивами: это дешевле поиска в хеш-таблице на каждую клетку окна
+    for (size_t i = 0; i < world.food_x.size(); ++i) {
+        if (!world.foodEnabled(i)) continue;
+        int x = world.food_x[i] - left, y = world.food_y[i] - top;
+        if (x < 0) x += world.width;
+        if (y < 0) y += world.height;
+        if (x < view_w && y < view_h) frame.at(x, y + 1) = '$';
+    }
+    world.occupancy.forEachIn(left, top, view_w, view_h, [&](int x, int y, uint8_t) {
+        frame.at(x, y + 1) = '*';
+    });
+    frame.at(view_w / 2, view_h / 2 + 1) = '@';
+}
+
+void Renderer::compose(const Arena& arena, Grid<char>& frame) const {
+    std::fill(frame.cells.begin(), frame.cells.end(), ' ');
+
+    char text[32];
+    print(frame, 0, 0, "  Use arrows for control. Press 'q' for EXIT");
+    snprintf(text, sizeof(text), "LEVEL: %u", arena.length[0]);
+    print(frame, arena.width - 10, 0, text);
+
+    for (int y = 0; y < arena.height; ++y) {
+        for (int x = 0; x < arena.width; ++x) {
+            uint32_t c = arena.cell(x, y);
+            uint32_t who = arena.owner.cells[c];
+            if (who != Arena::NO_SNAKE) {
+                frame.at(x, y + 1) = arena.bot[who - 1] ? '+' : '*';
+            } else if (arena.food_at.cells[c] >= 0) {
+                frame.at(x, y + 1) = '$';
+            }
+        }
+    }
+    for (size_t i = 0; i < arena.size(); ++i) {
+        if (arena.alive[i]) frame.at(arena.head_x[i], arena.head_y[i] + 1) = arena.bot[i] ? 'o' : '@';
+    }
+}
+
+void Renderer::print(Grid<char>& frame, int x, int y, const char* text) {
+    for (; *text && x < frame.width; ++text, ++x) {
+        if (x >= 0) frame.at(x, y) = *text;
+    }
+}
+
+void Renderer::present(const Grid<char>& frame) {
+    for (int y = 0; y < frame.height; ++y) {
+        for (int x = 0; x < frame.width; ++x) {
+            char ch = frame.at(x, y);
+            if (ch != front.at(x, y)) {
+                mvaddch(y, x, ch);
+            }
+        }
+    }
+    refresh();
+    front.cells = frame.cells;
+}
+
+int keyToDirection(int key) {
+    switch (key) {
+        case KEY_DOWN: return DOWN;
+        case KEY_UP: return UP;
+        case KEY_LEFT: return LEFT;
+        case KEY_RIGHT: return RIGHT;
+    }
+    return 0;
+}
@@ -0,0 +1,51 @@
+#ifndef SNAKE_RENDERER_H
+#define SNAKE_RENDERER_H
+
+/*
+ * Тонкий слой отрисовки GameState через ncurses.
+ * Строка 0 терминала занята статусом, игровое поле начинается со строки 1.
+ *
+ * Кадр сначала собирается в заднем буфере, затем сравнивается с передним
+ * (тем, что уже на экране): в терминал уходят только изменившиеся клетки,
+ * и за тик делается один refresh(). Сборку кадра (compose) можно делать в
+ * другом потоке, чем вывод (present), см. render_thread.h.
+ */
+
+#include "arena.h"
+#include "game.h"
+#include "world.h"
+
+class Renderer {
+public:
+    Renderer();
+    ~Renderer();
+
+    // Размер поля, которое помещается в терминал под строкой статуса
+    void boardSize(int& width, int& height) const;
+
+    int readKey(int timeout_ms);
+    void draw(const GameState& game);
+    void drawExit(const GameState& game) { drawExit(game.snake.tsize); }
+    void drawExit(size_t level);
+
+    // Пустой кадр размером с терминал
+    Grid<char> frameBuffer() const { return Grid<char>(back.width, back.height, ' '); }
+    // Собирает кадр игры в frame, не трогая терминал
+    void compose(const GameState& game, Grid<char>& frame) const;
+    // Для большого мира в кадр попадает окно вокруг головы змейки
+    void compose(const LargeWorld& world, Grid<char>& frame) const;
+    // На арене змейка игрока рисуется '*' и '@', боты — '+' и 'o'
+    void compose(const Arena& arena, Grid<char>& frame) const;
+    // Выводит готовый кадр размером frameBuffer()
+    void present(const Grid<char>& frame);
+
+private:
+    Grid<char> back, front;
+
+    static void print(Grid<char>& frame, int x, int y, const char* text);
+};
+
+// Переводит нажатую стрелку в направление; для прочих клавиш возвращает 0
+int keyToDirection(int key);
+
+#endif
@@ -0,0 +1,180 @@
+#include "replay.h"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char MAGIC[4] = {'S', 'N', 'K', 'R'};
+
+void putLe(uint8_t* out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) out[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+uint64_t getLe(const uint8_t* in, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) value |= static_cast<uint64_t>(in[i]) << (8 * i);
+    return value;
+}
+
+bool readVarint(const uint8_t*& pos, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; pos < end && shift < 64; shift += 7) {
+        uint8_t byte = *pos++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+}
+
+ReplayWriter::~ReplayWriter() {
+    if (file) fclose(file);
+}
+
+bool ReplayWriter::open(const std::string& path, const GameState& game, uint64_t seed) {
+    file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+    uint8_t header[REPLAY_HEADER_SIZE];
+    memcpy(header, MAGIC, sizeof(MAGIC));
+    header[4] = REPLAY_VERSION;
+    putLe(header + 5, game.width, 2);
+    putLe(header + 7, game.height, 2);
+    putLe(header + 9, game.food.size(), 4);
+    putLe(header + 13, seed, 8);
+    fwrite(header, 1, sizeof(header), file);
+    last_tick = game.tick;
+    return true;
+}
+
+void ReplayWriter::record(const GameState& game, int input) {
+    if (!file || !input || input == game.snake.direction) return;
+    uint64_t tick = game.tick + 1;
+    writeVarint(((tick - last_tick) << 2) | static_cast<uint64_t>(input - 1));
+    last_tick = tick;
+}
+
+bool ReplayWriter::close(const GameState& game) {
+    if (!file) return false;
+    writeVarint(0);
+    writeVarint(game.tick);
+    writeVarint(game.snake.tsize);
+    bool ok = ferror(file) == 0;
+    ok = fclose(file) == 0 && ok;
+    file = nullptr;
+    return ok;
+}
+
+void ReplayWriter::writeVarint(uint64_t value) {
+    uint8_t buffer[10];
+    int n = 0;
+    do {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        buffer[n++] = value ? (byte | 0x80) : byte;
+    } while (value);
+    fwrite(buffer, 1, n, file);
+}
+
+Replay::~Replay() {
+    if (data) munmap(const_cast<uint8_t*>(data), size);
+}
+
+bool Replay::open(const std::string& path, std::string& error) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open " + path;
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < REPLAY_HEADER_SIZE) {
+        close(fd);
+        error = path + ": file too short";
+        return false;
+    }
+    size = static_cast<size_t>(st.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        size = 0;
+        error = "cannot map " + path;
+        return false;
+    }
+    data = static_cast<const uint8_t*>(mapped);
+    // Файл читается подряд — подсказываем ядру читать наперёд
+    madvise(mapped, size, MADV_SEQUENTIAL);
+
+    if (memcmp(data, MAGIC, sizeof(MAGIC)) != 0 || data[4] != REPLAY_VERSION) {
+        error = path + ": not a snake replay";
+        return false;
+    }
+    width = static_cast<int>(getLe(data + 5, 2));
+    height = static_cast<int>(getLe(data + 7, 2));
+    food_count = static_cast<size_t>(getLe(data + 9, 4));
+    seed = getLe(data + 13, 8);
+    // Поле должно вместить начальную змейку, как в snake_batch, а еды не может
+    // быть больше, чем клеток: иначе GameState по такому заголовку не построить
+    if (width <= START_TAIL_SIZE || height <= 1 || width > MAX_BOARD_SIDE || height > MAX_BOARD_SIDE) {
+        error = path + ": unsupported board size " + std::to_string(width) + "x" + std::to_string(height);
+        return false;
+    }
+    if (food_count > static_cast<size_t>(width) * height) {
+        error = path + ": food count " + std::to_string(food_count) + " exceeds board cells";
+        return false;
+    }
+
+    // Пробегаем события до нулевого маркера, чтобы найти итог партии
+    const uint8_t* pos = data + REPLAY_HEADER_SIZE;
+    const uint8_t* end = data + size;
+    uint64_t value = 0;
+    while (true) {
+        const uint8_t* event = pos;
+        if (!readVarint(pos, end, value)) {
+            error = path + ": truncated";
+            return false;
+        }
+        if (value == 0) {
+            events_end = static_cast<size_t>(event - data);
+            break;
+        }
+    }
+    uint64_t length = 0;
+    if (!readVarint(pos, end, final_tick) || !readVarint(pos, end, length)) {
+        error = path + ": truncated";
+        return false;
+    }
+    final_length = static_cast<size_t>(length);
+    return true;
+}
+
+Replay::Cursor Replay::begin() const {
+    return {data + REPLAY_HEADER_SIZE, data + events_end, 0};
+}
+
+bool Replay::next(Cursor& cursor, uint64_t& tick, int& direction) const {
+    uint64_t value = 0;
+    if (cursor.pos >= cursor.end || !readVarint(cursor.pos, cursor.end, value)) return false;
+    cursor.tick += value >> 2;
+    tick = cursor.tick;
+    direction = static_cast<int>(value & 3) + 1;
+    return true;
+}
+
+void playReplay(const Replay& replay, GameState& game) {
+    Replay::Cursor cursor = replay.begin();
+    uint64_t event_tick = 0;
+    int direction = 0;
+    bool has_event = replay.next(cursor, event_tick, direction);
+    while (game.tick < replay.final_tick && !game.over) {
+        int input = 0;
+        if (has_event && event_tick == game.tick + 1) {
+            input = direction;
+            has_event = replay.next(cursor, event_tick, direction);
+        }
+        game.step(input);
+    }
+}
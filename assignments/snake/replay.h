@@ -0,0 +1,82 @@
+#ifndef SNAKE_REPLAY_H
+#define SNAKE_REPLAY_H
+
+/*
+ * Запись партии для точного воспроизведения. Партия полностью задаётся
+ * размером поля, числом еды, зерном и последовательностью поворотов,
+ * поэтому в файл пишутся только они.
+ *
+ * Формат (все числа little-endian):
+ *   "SNKR" | версия u8 | width u16 | height u16 | food_count u32 | seed u64
+ *   события: varint((тиков с прошлого события << 2) | (направление - 1))
+ *   0 — конец событий, затем varint(последний тик) и varint(итоговая длина)
+ * Промежуток между событиями не меньше 1, поэтому событие никогда не равно 0.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "game.h"
+
+enum {REPLAY_VERSION=1, REPLAY_HEADER_SIZE=21};
+
+class ReplayWriter {
+public:
+    ReplayWriter() = default;
+    ~ReplayWriter();
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+    bool open(const std::string& path, const GameState& game, uint64_t seed);
+    bool isOpen() const { return file != nullptr; }
+
+    // Вызывается перед game.step(input); пишет только настоящие повороты
+    void record(const GameState& game, int input);
+    // Дописывает итог партии и закрывает файл
+    bool close(const GameState& game);
+
+private:
+    FILE* file = nullptr;
+    uint64_t last_tick = 0;
+
+    void writeVarint(uint64_t value);
+};
+
+// Файл записи, отображённый в память целиком
+class Replay {
+public:
+    int width = 0, height = 0;
+    size_t food_count = 0;
+    uint64_t seed = 0;
+    uint64_t final_tick = 0;
+    size_t final_length = 0;
+
+    Replay() = default;
+    ~Replay();
+    Replay(const Replay&) = delete;
+    Replay& operator=(const Replay&) = delete;
+
+    // При ошибке возвращает false и описание в error
+    bool open(const std::string& path, std::string& error);
+
+    // Обход событий: начать с begin(), next() возвращает false в конце
+    struct Cursor {
+        const uint8_t* pos;
+        const uint8_t* end;
+        uint64_t tick;
+    };
+    Cursor begin() const;
+    bool next(Cursor& cursor, uint64_t& tick, int& direction) const;
+
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    size_t events_end = 0;
+};
+
+// Проигрывает запись без отрисовки; game должна быть создана по заголовку записи
+void playReplay(const Replay& replay, GameState& game);
+
+#endif
@@ -0,0 +1,87 @@
+#include "simd.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SNAKE_X86 1
+#include <immintrin.h>
+#endif
+
+size_t findCellScalar(const uint16_t* xs, const uint16_t* ys, size_t n, uint16_t x, uint16_t y) {
+    return findCell<uint16_t>(xs, ys, n, x, y);
+}
+
+#ifdef SNAKE_X86
+
+__attribute__((target("sse2")))
+size_t findCellSse2(const uint16_t* xs, const uint16_t* ys, size_t n, uint16_t x, uint16_t y) {
+    const __m128i vx = _mm_set1_epi16(static_cast<short>(x));
+    const __m128i vy = _mm_set1_epi16(static_cast<short>(y));
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i cx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(xs + i));
+        __m128i cy = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ys + i));
+        __m128i eq = _mm_and_si128(_mm_cmpeq_epi16(cx, vx), _mm_cmpeq_epi16(cy, vy));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(eq));
+        if (mask) return i + (__builtin_ctz(mask) >> 1);
+    }
+    return i + findCellScalar(xs + i, ys + i, n - i, x, y);
+}
+
+__attribute__((target("avx2")))
+size_t findCellAvx2(const uint16_t* xs, const uint16_t* ys, size_t n, uint16_t x, uint16_t y) {
+    const __m256i vx = _mm256_set1_epi16(static_cast<short>(x));
+    const __m256i vy = _mm256_set1_epi16(static_cast<short>(y));
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i cx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(xs + i));
+        __m256i cy = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ys + i));
+        __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi16(cx, vx), _mm256_cmpeq_epi16(cy, vy));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(eq));
+        if (mask) return i + (__builtin_ctz(mask) >> 1);
+    }
+    return i + findCellScalar(xs + i, ys + i, n - i, x, y);
+}
+
+#else
+
+size_t findCellSse2(const uint16_t* xs, const uint16_t* ys, size_t n, uint16_t x, uint16_t y) {
+    return findCellScalar(xs, ys, n, x, y);
+}
+
+size_t findCellAvx2(const uint16_t* xs, const uint16_t* ys, size_t n, uint16_t x, uint16_t y) {
+    return findCellScalar(xs, ys, n, x, y);
+}
+
+#endif
+
+namespace {
+
+using FindCellFn = size_t (*)(const uint16_t*, const uint16_t*, size_t, uint16_t, uint16_t);
+
+struct Kernel {
+    FindCellFn find;
+    const char* name;
+};
+
+Kernel detectKernel() {
+#ifdef SNAKE_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return {findCellAvx2, "avx2"};
+    if (__builtin_cpu_supports("sse2")) return {findCellSse2, "sse2"};
+#endif
+    return {findCellScalar, "scalar"};
+}
+
+const Kernel& kernel() {
+    static const Kernel selected = detectKernel();
+    return selected;
+}
+
+}
+
+size_t findCell(const uint16_t* xs, const uint16_t* ys, size_t n, uint16_t x, uint16_t y) {
+    return kernel().find(xs, ys, n, x, y);
+}
+
+const char* simdLevel() {
+    return kernel().name;
+}
@@ -0,0 +1,34 @@
+#ifndef SNAKE_SIMD_H
+#define SNAKE_SIMD_H
+
+/*
+ * Ядра поиска клетки в координатах, разложенных структурой массивов
+ * (отдельно все x, отдельно все y). Для 16-битных координат сравнение идёт
+ * по 16 (AVX2) или 8 (SSE2) элементов за раз; вариант выбирается один раз
+ * по возможностям процессора. Пригодится там, где держать сетку-индекс
+ * дороже, чем просмотреть массив, например в маленьких партиях пачкой.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+// Индекс первой пары (xs[i], ys[i]) == (x, y) или n, если такой нет
+template <typename Coord>
+size_t findCell(const Coord* xs, const Coord* ys, size_t n, Coord x, Coord y) {
+    for (size_t i = 0; i < n; ++i) {
+        if (xs[i] == x && ys[i] == y) return i;
+    }
+    return n;
+}
+
+size_t findCell(const uint16_t* xs, const uint16_t* ys, size_t n, uint16_t x, uint16_t y);
+
+// Отдельные варианты ядра — для замеров и проверок
+size_t findCellScalar(const uint16_t* xs, const uint16_t* ys, size_t n, uint16_t x, uint16_t y);
+size_t findCellSse2(const uint16_t* xs, const uint16_t* ys, size_t n, uint16_t x, uint16_t y);
+size_t findCellAvx2(const uint16_t* xs, const uint16_t* ys, size_t n, uint16_t x, uint16_t y);
+
+// Какой вариант выбран для findCell: "avx2", "sse2" или "scalar"
+const char* simdLevel();
+
+#endif
@@ -0,0 +1,67 @@
+/*
+ * snake_arena — нагрузочный прогон арены без терминала: все змейки
+ * управляются ботами, замеряется время тика.
+ *
+ * ./snake_arena [--snakes N] [--width W] [--height H] [--food F]
+ *               [--ticks T] [--seed S]
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "arena.h"
+#include "stats.h"
+
+using Clock = std::chrono::steady_clock;
+
+int main(int argc, char* argv[]) {
+    size_t snakes = 100;
+    int width = 400, height = 200;
+    size_t food_count = 200;
+    uint64_t ticks = 100000;
+    uint64_t seed = SEED_NUMBER;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--snakes") == 0) snakes = strtoull(argv[i + 1], nullptr, 10);
+        else if (strcmp(argv[i], "--width") == 0) width = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--height") == 0) height = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--food") == 0) food_count = strtoull(argv[i + 1], nullptr, 10);
+        else if (strcmp(argv[i], "--ticks") == 0) ticks = strtoull(argv[i + 1], nullptr, 10);
+        else if (strcmp(argv[i], "--seed") == 0) seed = strtoull(argv[i + 1], nullptr, 10);
+    }
+    if (width <= START_TAIL_SIZE || height <= START_TAIL_SIZE || width > MAX_BOARD_SIDE || height > MAX_BOARD_SIDE) {
+        fprintf(stderr, "Unsupported board size: %dx%d\n", width, height);
+        return 1;
+    }
+
+    Arena arena(width, height, snakes, 0, seed, food_count);
+    Histogram tick_ns;
+    uint64_t segment_ticks = 0;
+    size_t max_segments = 0;
+
+    Clock::time_point start = Clock::now();
+    for (uint64_t t = 0; t < ticks; ++t) {
+        Clock::time_point before = Clock::now();
+        arena.step(nullptr);
+        tick_ns.add(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - before).count());
+        size_t segments = arena.segments();
+        segment_ticks += segments;
+        if (segments > max_segments) max_segments = segments;
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    printf("%zu snakes on %dx%d, %zu food, %llu ticks in %.3f s\n", snakes, width, height, food_count,
+           static_cast<unsigned long long>(ticks), seconds);
+    printf("ticks/s: %.0f, snake-ticks/s: %.2f M\n", ticks / seconds, ticks * snakes / seconds / 1e6);
+    printf("tick ns: p50=%llu p99=%llu p99.9=%llu\n",
+           static_cast<unsigned long long>(tick_ns.percentile(50)),
+           static_cast<unsigned long long>(tick_ns.percentile(99)),
+           static_cast<unsigned long long>(tick_ns.percentile(99.9)));
+    printf("segments: mean %.0f, max %zu\n", static_cast<double>(segment_ticks) / ticks, max_segments);
+    printf("deaths: %llu, head-on: %llu\n", static_cast<unsigned long long>(arena.deaths),
+           static_cast<unsigned long long>(arena.head_on));
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * snake_replay — проигрывание записей партий (см. replay.h).
+ * По умолчанию каждая запись пересчитывается с максимальной скоростью без
+ * отрисовки, и итог сверяется с записанным. С --realtime первая запись
+ * показывается в терминале с заданной частотой тиков.
+ *
+ * ./snake_replay [--realtime] [--rate тиков_в_секунду] файл...
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "game.h"
+#include "renderer.h"
+#include "replay.h"
+
+enum {DEFAULT_REPLAY_RATE=10};
+
+using Clock = std::chrono::steady_clock;
+
+static bool playRealtime(const Replay& replay, int tick_rate) {
+    GameState game(replay.width, replay.height, replay.seed, replay.food_count);
+    bool fits = true;
+    {
+        Renderer renderer;
+        int width = 0, height = 0;
+        renderer.boardSize(width, height);
+        fits = replay.width <= width && replay.height <= height;
+        if (fits) {
+            const Clock::duration tick_period = std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(1.0 / tick_rate));
+            Replay::Cursor cursor = replay.begin();
+            uint64_t event_tick = 0;
+            int direction = 0;
+            bool has_event = replay.next(cursor, event_tick, direction);
+            Clock::time_point next_tick = Clock::now() + tick_period;
+
+            renderer.draw(game);
+            while (game.tick < replay.final_tick && !game.over) {
+                Clock::time_point now = Clock::now();
+                if (now < next_tick) {
+                    auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(next_tick - now);
+                    if (renderer.readKey(static_cast<int>(wait.count())) == STOP_GAME) break;
+                    continue;
+                }
+                int input = 0;
+                if (has_event && event_tick == game.tick + 1) {
+                    input = direction;
+                    has_event = replay.next(cursor, event_tick, direction);
+                }
+                game.step(input);
+                renderer.draw(game);
+                next_tick += tick_period;
+            }
+            renderer.drawExit(game);
+            renderer.readKey(SPEED);
+        }
+    }
+    if (!fits) {
+        fprintf(stderr, "Replay board %dx%d does not fit the terminal\n", replay.width, replay.height);
+    }
+    return fits;
+}
+
+int main(int argc, char* argv[]) {
+    bool realtime = false;
+    int tick_rate = DEFAULT_REPLAY_RATE;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--realtime") == 0) realtime = true;
+        else if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) tick_rate = atoi(argv[++i]);
+        else files.push_back(argv[i]);
+    }
+    if (files.empty()) {
+        fprintf(stderr, "Usage: %s [--realtime] [--rate N] file...\n", argv[0]);
+        return 1;
+    }
+    if (tick_rate <= 0) tick_rate = DEFAULT_REPLAY_RATE;
+
+    std::string error;
+    if (realtime) {
+        Replay replay;
+        if (!replay.open(files[0], error)) {
+            fprintf(stderr, "%s\n", error.c_str());
+            return 1;
+        }
+        return playRealtime(replay, tick_rate) ? 0 : 1;
+    }
+
+    size_t failed = 0;
+    uint64_t total_ticks = 0;
+    Clock::time_point start = Clock::now();
+    for (const auto& path : files) {
+        Replay replay;
+        if (!replay.open(path, error)) {
+            fprintf(stderr, "%s\n", error.c_str());
+            failed++;
+            continue;
+        }
+        GameState game(replay.width, replay.height, replay.seed, replay.food_count);
+        playReplay(replay, game);
+        total_ticks += game.tick;
+        // Расхождение с записанным итогом значит, что симуляция перестала быть детерминированной
+        if (game.tick != replay.final_tick || game.snake.tsize != replay.final_length) {
+            printf("%s: MISMATCH tick %llu/%llu length %zu/%zu\n", path.c_str(),
+                   static_cast<unsigned long long>(game.tick), static_cast<unsigned long long>(replay.final_tick),
+                   game.snake.tsize, replay.final_length);
+            failed++;
+        }
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    printf("%zu replays, %zu failed, %llu ticks in %.3f s (%.2f M ticks/s)\n",
+           files.size(), failed, static_cast<unsigned long long>(total_ticks), seconds,
+           total_ticks / seconds / 1e6);
+    return failed ? 1 : 0;
+}
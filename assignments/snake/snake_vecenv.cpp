@@ -0,0 +1,103 @@
+/*
+ * snake_vecenv — прогон VecEnv без терминала: все партии получают случайные
+ * действия, замеряется число шагов сред в секунду в одном потоке и в пуле.
+ * Заодно проверяется, что наблюдения, обновляемые по changed, совпадают
+ * с наблюдениями, собранными заново по всему полю, и что шаг в пуле даёт
+ * те же партии, что и последовательный.
+ *
+ * ./snake_vecenv [--envs N] [--width W] [--height H] [--steps T]
+ *                [--threads K] [--seed S]
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "random.h"
+#include "vec_env.h"
+#include "work_pool.h"
+
+using Clock = std::chrono::steady_clock;
+
+// Наблюдение партии i, собранное заново по сеткам занятости и еды
+static bool observationMatches(const VecEnv& env, size_t i) {
+    const GameState& game = env.games[i];
+    const uint8_t* obs = env.observation(i);
+    size_t head = game.occupancy.index(game.snake.x, game.snake.y);
+    for (size_t c = 0; c < env.observationSize(); ++c) {
+        uint8_t expected = c == head ? OBS_HEAD
+            : game.occupancy.cells[c] ? OBS_BODY
+            : game.food_at.cells[c] >= 0 ? OBS_FOOD : OBS_EMPTY;
+        if (obs[c] != expected) return false;
+    }
+    return true;
+}
+
+// Прогоняет steps шагов со случайными действиями; pool == nullptr — в одном потоке
+static double run(VecEnv& env, uint64_t steps, uint64_t seed, WorkStealingPool* pool) {
+    std::vector<uint64_t> seeds(env.count);
+    for (size_t i = 0; i < env.count; ++i) seeds[i] = seed + i;
+    env.reset(seeds.data());
+
+    Random rng(seed);
+    std::vector<int> actions(env.count);
+    Clock::time_point start = Clock::now();
+    for (uint64_t t = 0; t < steps; ++t) {
+        // Чаще всего змейка едет прямо, иначе поворачивает случайно
+        for (auto& a : actions) a = rng.below(4) ? 0 : static_cast<int>(rng.below(4)) + 1;
+        if (pool) env.step(actions.data(), *pool);
+        else env.step(actions.data());
+    }
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    size_t envs = 256;
+    int width = 20, height = 20;
+    uint64_t steps = 10000;
+    size_t threads = 0;
+    uint64_t seed = SEED_NUMBER;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--envs") == 0) envs = strtoull(argv[i + 1], nullptr, 10);
+        else if (strcmp(argv[i], "--width") == 0) width = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--height") == 0) height = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--steps") == 0) steps = strtoull(argv[i + 1], nullptr, 10);
+        else if (strcmp(argv[i], "--threads") == 0) threads = strtoull(argv[i + 1], nullptr, 10);
+        else if (strcmp(argv[i], "--seed") == 0) seed = strtoull(argv[i + 1], nullptr, 10);
+    }
+    if (width <= START_TAIL_SIZE || height <= 1 || width > MAX_BOARD_SIDE || height > MAX_BOARD_SIDE) {
+        fprintf(stderr, "Unsupported board size: %dx%d\n", width, height);
+        return 1;
+    }
+    if (envs == 0) {
+        fprintf(stderr, "--envs must be positive\n");
+        return 1;
+    }
+
+    VecEnv serial(envs, width, height);
+    VecEnv pooled(envs, width, height);
+    WorkStealingPool pool(threads);
+
+    double serial_s = run(serial, steps, seed, nullptr);
+    double pooled_s = run(pooled, steps, seed, &pool);
+
+    size_t stale = 0, diverged = 0;
+    for (size_t i = 0; i < envs; ++i) {
+        if (!observationMatches(serial, i)) stale++;
+        if (memcmp(serial.observation(i), pooled.observation(i), serial.observationSize()) != 0 ||
+            serial.games[i].tick != pooled.games[i].tick) {
+            diverged++;
+        }
+    }
+
+    double env_steps = static_cast<double>(envs) * steps;
+    printf("%zu envs on %dx%d, %llu steps\n", envs, width, height, static_cast<unsigned long long>(steps));
+    printf("1 thread:   %.3f s, %.2f M env-steps/s\n", serial_s, env_steps / serial_s / 1e6);
+    printf("pool of %zu: %.3f s, %.2f M env-steps/s\n", pool.size(), pooled_s, env_steps / pooled_s / 1e6);
+    printf("stale observations: %zu, pooled/serial mismatches: %zu\n", stale, diverged);
+    return stale || diverged ? 1 : 0;
+}
@@ -0,0 +1,53 @@
+#ifndef SNAKE_SPSC_RING_H
+#define SNAKE_SPSC_RING_H
+
+/*
+ * Кольцевая очередь без блокировок для одного писателя и одного читателя.
+ * Писатель двигает только head, читатель — только tail, поэтому хватает
+ * атомарных загрузок и записей с acquire/release. Индексы лежат в разных
+ * кэш-линиях, а каждая сторона помнит последнее увиденное значение чужого
+ * индекса и перечитывает его, только когда очередь кажется полной или пустой.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+template <typename T, size_t N>
+class SpscRing {
+    static_assert(N && (N & (N - 1)) == 0, "SpscRing size must be a power of two");
+
+public:
+    // Вызывается только писателем; false — очередь заполнена
+    bool push(const T& value) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h - tail_cache == N) {
+            tail_cache = tail.load(std::memory_order_acquire);
+            if (h - tail_cache == N) return false;
+        }
+        slots[h & (N - 1)] = value;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Вызывается только читателем; false — очередь пуста
+    bool pop(T& value) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t == head_cache) {
+            head_cache = head.load(std::memory_order_acquire);
+            if (t == head_cache) return false;
+        }
+        value = slots[t & (N - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    alignas(64) std::atomic<size_t> head{0};
+    size_t tail_cache = 0;
+    alignas(64) std::atomic<size_t> tail{0};
+    size_t head_cache = 0;
+    alignas(64) std::array<T, N> slots{};
+};
+
+#endif
@@ -0,0 +1,50 @@
+#include "stats.h"
+
+#include <algorithm>
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0;
+    size_t rank = static_cast<size_t>(p / 100.0 * (values.size() - 1) + 0.5);
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+}
+
+void Histogram::merge(const Histogram& other) {
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    count += other.count;
+}
+
+uint64_t Histogram::percentile(double p) const {
+    if (count == 0) return 0;
+    uint64_t rank = static_cast<uint64_t>(p / 100.0 * (count - 1));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen > rank) {
+            if (i < 4) return i;
+            int e = static_cast<int>(i / 4) + 1;
+            return static_cast<uint64_t>(4 + i % 4) << (e - 2);
+        }
+    }
+    return 0;
+}
+
+namespace {
+
+void printLine(FILE* out, const char* name, const std::vector<double>& values) {
+    fprintf(out, "%-14s n=%-8zu p50=%9.1f us  p99=%9.1f us\n",
+            name, values.size(), percentile(values, 50), percentile(values, 99));
+}
+
+}
+
+void FrameStats::report(FILE* out) const {
+    printLine(out, "update", update_us);
+    printLine(out, "render", render_us);
+    printLine(out, "input latency", input_latency_us);
+    fprintf(out, "catch-up ticks: %zu\n", catch_up_ticks);
+    fprintf(out, "dropped keys: %zu\n", dropped_keys);
+    fprintf(out, "skipped frames: %zu\n", skipped_frames);
+}
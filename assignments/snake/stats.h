@@ -0,0 +1,60 @@
+#ifndef SNAKE_STATS_H
+#define SNAKE_STATS_H
+
+/*
+ * Счётчики времени по тикам: обновление состояния, отрисовка и задержка
+ * от нажатия клавиши до кадра, который её показал. Всё в микросекундах.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+class FrameStats {
+public:
+    std::vector<double> update_us;
+    std::vector<double> render_us;
+    std::vector<double> input_latency_us;
+    // Сколько раз цикл не успевал и догонял пропущенные тики
+    size_t catch_up_ticks = 0;
+    // Нажатия, потерянные из-за переполненной очереди ввода
+    size_t dropped_keys = 0;
+    // Кадры, которые поток отрисовки пропустил, не успев их показать
+    size_t skipped_frames = 0;
+
+    void report(FILE* out) const;
+};
+
+// p в диапазоне [0, 100]; для пустого набора возвращает 0
+double percentile(std::vector<double> values, double p);
+
+// Гистограмма для миллионов замеров, которые нет смысла хранить поштучно.
+// Корзины логарифмические, по 4 на каждую степень двойки, так что
+// перцентиль известен с точностью около 25%.
+class Histogram {
+public:
+    enum {BUCKETS=256};
+
+    std::vector<uint64_t> buckets;
+    uint64_t count = 0;
+
+    Histogram() : buckets(BUCKETS) {}
+
+    void add(uint64_t value) {
+        buckets[bucketOf(value)]++;
+        count++;
+    }
+
+    void merge(const Histogram& other);
+    // Нижняя граница корзины, в которую попал p-й перцентиль
+    uint64_t percentile(double p) const;
+
+private:
+    static size_t bucketOf(uint64_t value) {
+        if (value < 4) return value;
+        int e = 63 - __builtin_clzll(value);
+        return 4 * (e - 1) + ((value >> (e - 2)) & 3);
+    }
+};
+
+#endif
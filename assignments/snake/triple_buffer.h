@@ -0,0 +1,47 @@
+#ifndef SNAKE_TRIPLE_BUFFER_H
+#define SNAKE_TRIPLE_BUFFER_H
+
+/*
+ * Тройной буфер для передачи кадров из одного потока в другой без ожидания.
+ * Писатель заполняет свой слот back() и публикует его обменом со средним,
+ * читатель забирает средний слот обменом со своим front(). Ни одна сторона
+ * не ждёт другую: если читатель не успевает, промежуточные кадры просто
+ * перезаписываются, и он видит только самый свежий.
+ */
+
+#include <array>
+#include <atomic>
+
+template <typename T>
+class TripleBuffer {
+public:
+    explicit TripleBuffer(const T& value) : slots{{value, value, value}} {}
+
+    // Слот писателя; после publish() писатель получает другой слот
+    T& back() { return slots[back_index]; }
+
+    void publish() {
+        back_index = middle.exchange(back_index | FRESH, std::memory_order_acq_rel) & INDEX;
+    }
+
+    // Забирает опубликованный кадр, если он новый; возвращает false, если нового нет
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        front_index = middle.exchange(front_index, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+
+    // Слот читателя: последний забранный update() кадр
+    const T& front() const { return slots[front_index]; }
+
+private:
+    enum {INDEX=3, FRESH=4};
+
+    std::array<T, 3> slots;
+    // Индекс среднего слота и бит FRESH, если писатель положил туда новый кадр
+    std::atomic<int> middle{1};
+    int back_index = 0;
+    int front_index = 2;
+};
+
+#endif
@@ -0,0 +1,86 @@
+#include "vec_env.h"
+
+#include <algorithm>
+
+// Сколько кусков на рабочего: с запасом, чтобы кража работы выравнивала нагрузку
+enum {CHUNKS_PER_WORKER=4};
+
+VecEnv::VecEnv(size_t count, int width, int height, size_t food_count, uint64_t max_episode_ticks)
+    : width(width), height(height), count(count), max_episode_ticks(max_episode_ticks),
+      observations(count * static_cast<size_t>(width) * height), rewards(count), dones(count),
+      step_actions(nullptr), step_chunk_size(0) {
+    step_chunk = [this](size_t chunk) {
+        size_t begin = chunk * step_chunk_size;
+        stepRange(step_actions, begin, std::min(this->count, begin + step_chunk_size));
+    };
+    games.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        games.emplace_back(width, height, SEED_NUMBER + i, food_count);
+    }
+}
+
+void VecEnv::reset(const uint64_t* seeds) {
+    for (size_t i = 0; i < count; ++i) {
+        games[i].reset(seeds[i]);
+        rewards[i] = 0;
+        dones[i] = 0;
+        observe(i);
+    }
+}
+
+void VecEnv::step(const int* actions) {
+    stepRange(actions, 0, count);
+}
+
+void VecEnv::stepRange(const int* actions, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        GameState& game = games[i];
+        size_t old_head = game.occupancy.index(game.snake.x, game.snake.y);
+        StepResult result = game.step(actions[i]);
+        rewards[i] = result == STEP_ATE ? 1.0f : result == STEP_CRASHED ? -1.0f : 0.0f;
+        bool done = result == STEP_CRASHED || game.tick >= max_episode_ticks;
+        dones[i] = done;
+        if (done) {
+            game.reset(game.rng.next());
+            observe(i);
+            continue;
+        }
+        // Наблюдение обновляется только в клетках, которые тронул этот тик
+        uint8_t* obs = observations.data() + i * observationSize();
+        for (uint32_t cell : game.changed) {
+            obs[cell] = observeCell(game, cell);
+        }
+        obs[old_head] = observeCell(game, old_head);
+        obs[game.occupancy.index(game.snake.x, game.snake.y)] = OBS_HEAD;
+    }
+}
+
+void VecEnv::step(const int* actions, WorkStealingPool& pool) {
+    size_t chunks = std::min(count, (pool.size() + 1) * CHUNKS_PER_WORKER);
+    if (chunks <= 1) {
+        step(actions);
+        return;
+    }
+    step_actions = actions;
+    step_chunk_size = (count + chunks - 1) / chunks;
+    pool.run((count + step_chunk_size - 1) / step_chunk_size, step_chunk);
+}
+
+uint8_t VecEnv::observeCell(const GameState& game, size_t cell) const {
+    if (game.occupancy.cells[cell]) return OBS_BODY;
+    return game.food_at.cells[cell] >= 0 ? OBS_FOOD : OBS_EMPTY;
+}
+
+void VecEnv::observe(size_t i) {
+    const GameState& game = games[i];
+    uint8_t* obs = observations.data() + i * observationSize();
+    const uint8_t* occupancy = game.occupancy.cells.data();
+    const int32_t* food_at = game.food_at.cells.data();
+    size_t cells = observationSize();
+    // Без ветвлений, чтобы цикл векторизовался: змейка важнее еды, еда важнее пустоты
+    for (size_t c = 0; c < cells; ++c) {
+        uint8_t food = food_at[c] >= 0 ? OBS_FOOD : OBS_EMPTY;
+        obs[c] = occupancy[c] ? static_cast<uint8_t>(OBS_BODY) : food;
+    }
+    obs[game.occupancy.index(game.snake.x, game.snake.y)] = OBS_HEAD;
+}
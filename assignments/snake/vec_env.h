@@ -0,0 +1,68 @@
+#ifndef SNAKE_VEC_ENV_H
+#define SNAKE_VEC_ENV_H
+
+/*
+ * Векторная среда в духе Gym для обучения политик: N партий идут в ногу,
+ * step(actions) продвигает все на один тик и пишет наблюдения, награды
+ * и флаги завершения в заранее выделенные непрерывные буферы.
+ * Законченная партия сразу начинается заново (зерно берётся из её генератора),
+ * а наблюдение в буфере — уже от новой партии, как в SB3 VecEnv.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "game.h"
+#include "work_pool.h"
+
+// Значения клеток в наблюдении
+enum {OBS_EMPTY=0, OBS_BODY, OBS_HEAD, OBS_FOOD};
+
+enum {DEFAULT_EPISODE_TICKS=10000};
+
+class VecEnv {
+public:
+    int width, height;
+    size_t count;
+    // Партия обрывается (done = 1) после стольких тиков, даже если змейка жива
+    uint64_t max_episode_ticks;
+
+    std::vector<GameState> games;
+    // count наблюдений по width * height байт подряд
+    std::vector<uint8_t> observations;
+    std::vector<float> rewards;
+    std::vector<uint8_t> dones;
+
+    VecEnv(size_t count, int width, int height, size_t food_count = MAX_FOOD_SIZE,
+           uint64_t max_episode_ticks = DEFAULT_EPISODE_TICKS);
+    // step_chunk держит this, поэтому среду нельзя копировать
+    VecEnv(const VecEnv&) = delete;
+    VecEnv& operator=(const VecEnv&) = delete;
+
+    size_t observationSize() const { return static_cast<size_t>(width) * height; }
+    const uint8_t* observation(size_t i) const { return observations.data() + i * observationSize(); }
+
+    // seeds — count зёрен, по одному на партию
+    void reset(const uint64_t* seeds);
+
+    // actions — count направлений (LEFT/UP/RIGHT/DOWN или 0)
+    void step(const int* actions);
+    // Шаг партий [begin, end). Разные диапазоны можно шагать из разных потоков одновременно
+    void stepRange(const int* actions, size_t begin, size_t end);
+    // Шаг всех партий, разбитых на куски между рабочими пула и вызывающим потоком.
+    // Как и step(actions), ничего не выделяет
+    void step(const int* actions, WorkStealingPool& pool);
+
+private:
+    // Задача для пула собирается один раз в конструкторе; шаг только меняет её аргументы
+    std::function<void(size_t)> step_chunk;
+    const int* step_actions;
+    size_t step_chunk_size;
+
+    void observe(size_t i);
+    uint8_t observeCell(const GameState& game, size_t cell) const;
+};
+
+#endif
@@ -0,0 +1,125 @@
+#include "work_pool.h"
+
+WorkStealingPool::WorkStealingPool(size_t count)
+    : queued(0), pending(0), next_worker(0), stopping(false),
+      batch_body(nullptr), batch_size(0), batch_next(0), batch_left(0) {
+    if (count == 0) count = std::thread::hardware_concurrency();
+    if (count == 0) count = 1;
+    for (size_t i = 0; i < count; ++i) {
+        workers.emplace_back(new Worker);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        threads.emplace_back(&WorkStealingPool::work, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
+void WorkStealingPool::submit(std::function<void()> task) {
+    pending++;
+    Worker& worker = *workers[next_worker++ % workers.size()];
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        // queued растёт раньше, чем задачу можно забрать, иначе вор успеет
+        // уменьшить его первым и счётчик уйдёт через ноль. Меняется он под
+        // state_mutex, чтобы спящий рабочий не пропустил пробуждение
+        {
+            std::lock_guard<std::mutex> state(state_mutex);
+            queued++;
+        }
+        worker.tasks.push_back(std::move(task));
+    }
+    wake.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(state_mutex);
+    done.wait(lock, [this] { return pending == 0; });
+}
+
+void WorkStealingPool::run(size_t n, const std::function<void(size_t)>& body) {
+    if (n == 0) return;
+    std::unique_lock<std::mutex> lock(state_mutex);
+    batch_body = &body;
+    batch_size = n;
+    batch_next = 0;
+    batch_left = n;
+    lock.unlock();
+    wake.notify_all();
+
+    lock.lock();
+    while (runBatchItem(lock)) {}
+    done.wait(lock, [this] { return batch_left == 0; });
+    batch_body = nullptr;
+    batch_size = batch_next = 0;
+}
+
+// Берёт очередной индекс текущего run(n, body) и выполняет его без блокировки
+bool WorkStealingPool::runBatchItem(std::unique_lock<std::mutex>& lock) {
+    if (batch_next >= batch_size) return false;
+    size_t i = batch_next++;
+    const std::function<void(size_t)>& body = *batch_body;
+    lock.unlock();
+    body(i);
+    lock.lock();
+    if (--batch_left == 0) done.notify_all();
+    return true;
+}
+
+// Вызывается под мьютексом очереди, из которой только что взята задача
+void WorkStealingPool::taken() {
+    std::lock_guard<std::mutex> lock(state_mutex);
+    queued--;
+}
+
+bool WorkStealingPool::popTask(size_t index, std::function<void()>& task) {
+    {
+        Worker& own = *workers[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            taken();
+            return true;
+        }
+    }
+    for (size_t k = 1; k < workers.size(); ++k) {
+        Worker& victim = *workers[(index + k) % workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            taken();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::work(size_t index) {
+    std::function<void()> task;
+    while (true) {
+        if (popTask(index, task)) {
+            task();
+            task = nullptr;
+            if (--pending == 0) {
+                std::lock_guard<std::mutex> lock(state_mutex);
+                done.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(state_mutex);
+        wake.wait(lock, [this] { return stopping || queued > 0 || batch_next < batch_size; });
+        while (runBatchItem(lock)) {}
+        if (stopping && queued == 0) return;
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef SNAKE_WORK_POOL_H
+#define SNAKE_WORK_POOL_H
+
+/*
+ * Пул потоков с кражей работы. У каждого рабочего своя очередь задач:
+ * он берёт задачи с её конца, а опустошив свою, забирает задачи с начала
+ * чужих очередей. Так длинные и короткие задачи распределяются сами собой.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool {
+public:
+    // threads == 0 — по числу аппаратных потоков
+    explicit WorkStealingPool(size_t threads = 0);
+    ~WorkStealingPool();
+
+    size_t size() const { return threads.size(); }
+
+    void submit(std::function<void()> task);
+    // Ждёт, пока не выполнятся все отправленные задачи
+    void wait();
+    // Вызывает body(0), ..., body(n - 1) на рабочих и в вызывающем потоке и ждёт
+    // их завершения. body не копируется и задачи не встают в очереди, поэтому
+    // вызов ничего не выделяет. Вызывать из задачи этого же пула нельзя
+    void run(size_t n, const std::function<void(size_t)>& body);
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    std::mutex state_mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::atomic<size_t> queued;
+    std::atomic<size_t> pending;
+    std::atomic<size_t> next_worker;
+    bool stopping;
+    // Текущий вызов run(n, body): следующий индекс и сколько вызовов ещё не закончилось.
+    // Всё меняется под state_mutex
+    const std::function<void(size_t)>* batch_body;
+    size_t batch_size;
+    size_t batch_next;
+    size_t batch_left;
+
+    void work(size_t index);
+    bool popTask(size_t index, std::function<void()>& task);
+    void taken();
+    bool runBatchItem(std::unique_lock<std::mutex>& lock);
+};
+
+#endif
@@ -0,0 +1,88 @@
+#include "world.h"
+
+LargeWorld::LargeWorld(int width, int height, uint64_t seed, size_t food_count)
+    : width(width), height(height), snake(width / 2, height / 2),
+      occupancy(width, height),
+      food_x(food_count, NO_FOOD), food_y(food_count, NO_FOOD), put_tick(food_count, 0),
+      expiry_wheel(FOOD_EXPIRE_TICKS + 1), rng(seed), tick(0), over(false) {
+    for (size_t i = 0; i < snake.tsize; ++i) {
+        Segment t = snake.segment(i);
+        occupy(t.x, t.y);
+    }
+    for (size_t i = 0; i < food_count; ++i) {
+        putFood(i);
+    }
+}
+
+StepResult LargeWorld::step(int input) {
+    if (over) return STEP_CRASHED;
+    if (input) snake.direction = input;
+    tick++;
+
+    Segment vacated = snake.segment(snake.tsize - 1);
+    release(vacated.x, vacated.y);
+
+    snake.move(width, height);
+    snake.moveTail();
+
+    if (occupancy.get(snake.x, snake.y)) {
+        over = true;
+        return STEP_CRASHED;
+    }
+    occupy(snake.x, snake.y);
+
+    bool ate = false;
+    auto found = food_at.find(cellId(snake.x, snake.y));
+    if (found != food_at.end()) {
+        ate = true;
+        snake.addTail(vacated);
+        occupy(vacated.x, vacated.y);
+        putFood(found->second);
+    }
+
+    std::vector<size_t>& slot = expiry_wheel[tick % expiry_wheel.size()];
+    for (size_t k = 0; k < slot.size(); ++k) {
+        size_t i = slot[k];
+        if (!foodEnabled(i) || put_tick[i] + FOOD_EXPIRE_TICKS == tick) putFood(i);
+    }
+    // Еда, выложенная в один тик, и протухает вместе, так что через слот по
+    // очереди проходит вся пачка. Память большого слота отдаём сразу, иначе
+    // каждый слот колеса держал бы её до конца партии
+    if (slot.capacity() > WHEEL_SLOT_KEEP) std::vector<size_t>().swap(slot);
+    else slot.clear();
+
+    return ate ? STEP_ATE : STEP_MOVED;
+}
+
+void LargeWorld::putFood(size_t i) {
+    if (foodEnabled(i)) {
+        food_at.erase(cellId(food_x[i], food_y[i]));
+        food_x[i] = NO_FOOD;
+    }
+    // Мир почти пуст, поэтому случайная клетка почти всегда свободна
+    uint64_t cells = static_cast<uint64_t>(width) * height;
+    for (int attempt = 0; attempt < FOOD_PLACE_ATTEMPTS; ++attempt) {
+        uint64_t cell = rng.below(cells);
+        int x = static_cast<int>(cell % width), y = static_cast<int>(cell / width);
+        if (occupancy.get(x, y) || food_at.count(cell)) continue;
+        food_x[i] = x;
+        food_y[i] = y;
+        food_at.emplace(cell, i);
+        put_tick[i] = tick;
+        expiry_wheel[(tick + FOOD_EXPIRE_TICKS) % expiry_wheel.size()].push_back(i);
+        return;
+    }
+    // Не нашли места — пробуем в следующем тике
+    expiry_wheel[(tick + 1) % expiry_wheel.size()].push_back(i);
+}
+
+size_t LargeWorld::memoryBytes() const {
+    size_t wheel = 0;
+    for (const auto& slot : expiry_wheel) wheel += slot.capacity() * sizeof(size_t);
+    // Узел хеш-таблицы: ключ, значение, указатель на следующий и хеш
+    size_t food_nodes = food_at.size() * (sizeof(uint64_t) + 3 * sizeof(size_t))
+        + food_at.bucket_count() * sizeof(void*);
+    return occupancy.memoryBytes() + food_nodes
+        + snake.capacity() * 2 * sizeof(int32_t)
+        + food_x.size() * (2 * sizeof(int32_t) + sizeof(uint64_t)) + wheel;
+}
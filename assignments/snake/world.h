@@ -0,0 +1,64 @@
+#ifndef SNAKE_WORLD_H
+#define SNAKE_WORLD_H
+
+/*
+ * Режим большого мира: поле до MAX_WORLD_SIDE x MAX_WORLD_SIDE клеток,
+ * намного больше терминала. Правила те же, что в GameState, но занятость
+ * лежит в разреженной ChunkGrid, еда — в хеш-таблице по номеру клетки
+ * (она разбросана по всему миру, и кусок на каждую еду был бы слишком
+ * дорог), а место для еды выбирается случайной пробой вместо списка
+ * свободных клеток. Так память пропорциональна занятым клеткам, а не
+ * площади поля. Экран показывает окно вокруг головы (см. Renderer::compose).
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "chunk_grid.h"
+#include "game.h"
+
+enum {MAX_WORLD_SIDE=100000, FOOD_PLACE_ATTEMPTS=64};
+// Сколько записей слот колеса таймеров сохраняет за собой после обработки
+enum {WHEEL_SLOT_KEEP=64};
+
+class LargeWorld {
+public:
+    using WorldSnake = BasicSnake<int32_t>;
+    using Segment = WorldSnake::Segment;
+
+    static constexpr int32_t NO_FOOD = -1;
+
+    int width, height;
+    WorldSnake snake;
+    // Сколько сегментов змейки занимают клетку
+    ChunkGrid<uint8_t> occupancy;
+    // Индекс еды по номеру клетки y * width + x
+    std::unordered_map<uint64_t, size_t> food_at;
+    std::vector<int32_t> food_x, food_y;
+    std::vector<uint64_t> put_tick;
+    // Колесо таймеров протухания еды, как в GameState. Обработанные слоты
+    // освобождают память, так что колесо занимает порядка числа живых таймеров
+    std::vector<std::vector<size_t>> expiry_wheel;
+    Random rng;
+    uint64_t tick;
+    bool over;
+
+    // Змейка появляется в центре мира. Стороны не больше MAX_WORLD_SIDE
+    LargeWorld(int width, int height, uint64_t seed = SEED_NUMBER, size_t food_count = MAX_FOOD_SIZE);
+
+    StepResult step(int input);
+
+    bool foodEnabled(size_t i) const { return food_x[i] != NO_FOOD; }
+    uint64_t cellId(int x, int y) const { return static_cast<uint64_t>(y) * width + x; }
+    // Память под сетки, хвост и еду
+    size_t memoryBytes() const;
+
+private:
+    void occupy(int x, int y) { occupancy.set(x, y, occupancy.get(x, y) + 1); }
+    void release(int x, int y) { occupancy.set(x, y, occupancy.get(x, y) - 1); }
+    void putFood(size_t i);
+};
+
+#endif